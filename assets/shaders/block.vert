@@ -1,23 +1,40 @@
 #version 410 core
 
 layout (location = 0) in vec2 aPos;
-layout (location = 3) in ivec3 data;
+layout (location = 3) in ivec4 data;
 
 out vec2 vTexPos;
+out float vLight;
 
 layout(std140) uniform Matrices {
 	mat4 proj;
 };
-uniform vec2 offset;
+// Corner and size of the texture of every item in the atlas
+layout(std140) uniform Atlas {
+	vec4 rects[64];
+};
+// Same for everything drawn in a frame
+layout(std140) uniform Frame {
+	vec2 camera;
+	float time;
+};
 
 void main() {
-	vec2 pos = (aPos + vec2(data.xy)) * vec2(16.0f, 16.0f) * 7.0f + offset;
+	// Chunks have an instance for every tile, air is moved out of the screen
+	if (data.z == 0) {
+		gl_Position = vec4(2.0f, 2.0f, 2.0f, 1.0f);
+		vTexPos = vec2(0.0f, 0.0f);
+		vLight = 0.0f;
+
+		return;
+	}
+
+	vec2 pos = (aPos + vec2(data.xy)) * vec2(16.0f, 16.0f) * 7.0f + camera;
 	gl_Position = proj * vec4(pos, 0.0f, 1.0f);
 
-	// One block is this size
-	vec2 texSpriteSize = vec2(1.0f, 1.0f) / vec2(64.0f, 64.0f);
-	vec2 texPos = aPos;
-	vec2 texSpritePos = texSpriteSize * texPos;
+	vec4 rect = rects[data.z];
+	vTexPos = rect.xy + rect.zw * vec2(aPos.x, aPos.y * -1.0f + 1.0f);
 
-	vTexPos = texSpriteSize * vec2(data.z % 64, data.z / 64) + texSpritePos;
+	// Every light level is 80% of the one above, with a bit of ambient so caves aren't pitch black
+	vLight = max(pow(0.8f, float(15 - data.w)), 0.05f);
 }
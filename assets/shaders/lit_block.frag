@@ -0,0 +1,19 @@
+#version 410 core
+precision mediump float;
+
+in vec2 vTexPos;
+in float vLight;
+
+layout (location = 0) out vec4 color;
+
+uniform sampler2D texture_diffuse;
+
+void main() {
+	color = texture(texture_diffuse, vTexPos);
+
+	if (color.a < 0.1) {
+		discard;
+	}
+
+	color.rgb *= vLight;
+}
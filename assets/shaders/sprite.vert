@@ -0,0 +1,23 @@
+#version 410 core
+
+layout (location = 0) in vec2 aPos;
+// Position and size in pixels
+layout (location = 3) in vec4 rect;
+// Corner and size of the region in the texture, negative sizes flip it
+layout (location = 4) in vec4 uv;
+
+out vec2 vTexPos;
+
+layout(std140) uniform Matrices {
+	mat4 proj;
+};
+layout(std140) uniform Frame {
+	vec2 camera;
+	float time;
+};
+
+void main() {
+	gl_Position = proj * vec4(aPos * rect.zw + rect.xy + camera, 0.0f, 1.0f);
+
+	vTexPos = uv.xy + uv.zw * vec2(aPos.x, aPos.y * -1.0f + 1.0f);
+}
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# Packs textures into atlas pages and writes where each one ended up
+#
+# Usage: atlas.py [textures dir] [files or dirs...]
+# Writes atlas-N.png and atlas.json in the textures dir, the json maps the path of every texture (relative to the
+# textures dir) to [page, x, y, width, height] in pixels
+import json
+import os
+import struct
+import sys
+import zlib
+
+# Max size of a page, GLES 3 guarantees 2048
+PAGE_SIZE = 1024
+# Edge pixels are copied around every texture so nearest sampling at the border never reads the neighbour
+PADDING = 1
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+def readPng(path):
+    with open(path, "rb") as file:
+        data = file.read()
+
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError(f"{path}: not a png (git lfs pull?)")
+
+    offset = 8
+    idat = b""
+    palette = []
+    alpha = []
+    while offset < len(data):
+        length, kind = struct.unpack(">I4s", data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            alpha = list(chunk)
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    if interlace != 0:
+        raise ValueError(f"{path}: interlaced pngs aren't supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    if depth == 16:
+        raise ValueError(f"{path}: 16 bit pngs aren't supported")
+
+    # Bytes per pixel for the filters and bytes per row
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+
+    raw = zlib.decompress(idat)
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind = raw[start]
+        row = bytearray(raw[start + 1:start + 1 + stride])
+
+        for x in range(stride):
+            a = row[x - bpp] if x >= bpp else 0
+            b = previous[x]
+            c = previous[x - bpp] if x >= bpp else 0
+
+            if kind == 1:
+                row[x] = (row[x] + a) & 0xFF
+            elif kind == 2:
+                row[x] = (row[x] + b) & 0xFF
+            elif kind == 3:
+                row[x] = (row[x] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                row[x] = (row[x] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+
+        rows.append(row)
+        previous = row
+
+    # Everything to RGBA
+    pixels = []
+    for row in rows:
+        if depth < 8:
+            samples = [(row[i * depth // 8] >> (8 - depth - (i * depth) % 8)) & ((1 << depth) - 1)
+                       for i in range(width)]
+        else:
+            samples = row
+
+        out = []
+        for x in range(width):
+            if color == 0:
+                value = samples[x] * 255 // ((1 << depth) - 1)
+                out.append((value, value, value, 255))
+            elif color == 2:
+                out.append((*samples[x * 3:x * 3 + 3], 255))
+            elif color == 3:
+                index = samples[x]
+                out.append((*palette[index], alpha[index] if index < len(alpha) else 255))
+            elif color == 4:
+                out.append((samples[x * 2], samples[x * 2], samples[x * 2], samples[x * 2 + 1]))
+            else:
+                out.append(tuple(samples[x * 4:x * 4 + 4]))
+
+        pixels.append(out)
+
+    return width, height, pixels
+
+def writePng(path, width, height, pixels):
+    raw = bytearray()
+    for row in pixels:
+        raw.append(0)
+        for pixel in row:
+            raw.extend(pixel)
+
+    def chunk(kind, data):
+        return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data))
+
+    with open(path, "wb") as file:
+        file.write(PNG_SIGNATURE)
+        file.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 6, 0, 0, 0)))
+        file.write(chunk(b"IDAT", zlib.compress(bytes(raw), 9)))
+        file.write(chunk(b"IEND", b""))
+
+# Shelf packing, the textures are placed tallest first in rows from the top left
+# The order of the arguments decides the page, the first ones always end up on the first page
+def pack(textures):
+    pages = []
+    placed = {}
+
+    shelf = None
+    for name, (width, height, _) in sorted(textures.items(), key=lambda t: (t[1][2], -t[1][1], t[0])):
+        w = width + PADDING * 2
+        h = height + PADDING * 2
+        if w > PAGE_SIZE or h > PAGE_SIZE:
+            raise ValueError(f"{name}: {width}x{height} doesn't fit in a {PAGE_SIZE}x{PAGE_SIZE} page")
+
+        if shelf is None or shelf["x"] + w > PAGE_SIZE:
+            # Next shelf, or next page
+            y = 0 if shelf is None else shelf["y"] + shelf["height"]
+            if shelf is None or y + h > PAGE_SIZE:
+                pages.append({"width": 0, "height": 0})
+                y = 0
+
+            shelf = {"x": 0, "y": y, "height": h}
+
+        shelf["height"] = max(shelf["height"], h)
+        placed[name] = (len(pages) - 1, shelf["x"] + PADDING, shelf["y"] + PADDING, width, height)
+
+        page = pages[-1]
+        page["width"] = max(page["width"], shelf["x"] + w)
+        page["height"] = max(page["height"], shelf["y"] + shelf["height"])
+        shelf["x"] += w
+
+    # Power of two pages
+    for page in pages:
+        for key in ("width", "height"):
+            size = 1
+            while size < page[key]:
+                size *= 2
+            page[key] = size
+
+    return pages, placed
+
+if len(sys.argv) < 3:
+    print(f"Usage: {sys.argv[0]} [textures dir] [files or dirs...]")
+
+    exit(1)
+
+root = sys.argv[1]
+
+# name -> (width, height, pixels, argument index)
+textures = {}
+for i, argument in enumerate(sys.argv[2:]):
+    path = os.path.join(root, argument)
+    files = [os.path.join(argument, f) for f in sorted(os.listdir(path))] if os.path.isdir(path) else [argument]
+
+    for name in files:
+        if name.endswith(".png") and not os.path.basename(name).startswith("atlas"):
+            textures[name.replace(os.sep, "/")] = (*readPng(os.path.join(root, name)), i)
+
+pages, placed = pack({name: (w, h, i) for name, (w, h, _, i) in textures.items()})
+
+images = [[[(0, 0, 0, 0)] * page["width"] for _ in range(page["height"])] for page in pages]
+for name, (page, x, y, width, height) in placed.items():
+    pixels = textures[name][2]
+    image = images[page]
+
+    for dy in range(-PADDING, height + PADDING):
+        for dx in range(-PADDING, width + PADDING):
+            image[y + dy][x + dx] = pixels[min(max(dy, 0), height - 1)][min(max(dx, 0), width - 1)]
+
+output = {"pages": [], "textures": {}}
+for page, image in enumerate(images):
+    name = f"atlas-{page}.png"
+    writePng(os.path.join(root, name), pages[page]["width"], pages[page]["height"], image)
+
+    output["pages"].append({"file": name, "width": pages[page]["width"], "height": pages[page]["height"]})
+
+for name in sorted(placed):
+    output["textures"][name] = list(placed[name])
+
+with open(os.path.join(root, "atlas.json"), "w") as file:
+    json.dump(output, file)
+
+print(f"Packed {len(placed)} textures into {len(pages)} page(s)")
@@ -36,6 +36,9 @@ struct velocity {
 	velocity(const decltype(mVelocity) vel) noexcept : mVelocity(vel) {}
 };
 
+// Rested long enough to stop being simulated, has no velocity until it gets woken up
+struct sleeping {};
+
 struct collision {
 	Eigen::Vector2f mOffset;
 	Eigen::Vector2f mSize;
@@ -108,5 +111,9 @@ struct inventory {
 
 struct item {
 	Item mType;
+	// Stacks lying next to each other get merged
+	std::uint64_t mCount;
+
+	item(const decltype(mType) type, const decltype(mCount) count = 1) noexcept : mType(type), mCount(count) {}
 };
 } // namespace Components
@@ -18,10 +18,21 @@ class FurnaceInventory : public Inventory {
 	~FurnaceInventory() override = default;
 
 	bool update(class Scene* scene, float delta) override;
-	void tick(class Scene* scene, float delta);
+	// Called by the furnace blocks with the current game tick
+	// There's a single furnace, every furnace block opens and ticks this inventory, so it runs while any of them is
+	// loaded and catches up on the time all of them were unloaded
+	void tick(class Scene* scene, const std::uint64_t tick);
+	// A furnace block got placed, if none was running the furnace starts fresh instead of catching up
+	void placed(const std::uint64_t tick);
 	void draw(class Scene* scene) override;
 
       private:
+	// Recipes or fuel items a catch up goes through at most
+	constexpr const static inline std::uint64_t MAX_CATCH_UP = 256;
+
+	// Runs the furnace for delta seconds, at most one item gets smelted or burnt, false if it stopped
+	bool smelt(const double delta);
+
 	std::vector<Components::Item> mSmeltingItems;
 	std::vector<std::uint64_t> mSmeltingCount;
 
@@ -30,6 +41,8 @@ class FurnaceInventory : public Inventory {
 	double mRecipieTime;
 
 	Components::Item mLastRecipie;
+	// 0 if it never ticked
+	std::uint64_t mLastTick;
 
 	constexpr const static inline double mFuelOffsetX = 55;
 	constexpr const static inline double mFuelOffsetY = 98;
@@ -18,6 +18,9 @@ class NoiseGenerator {
 	double getNoise(std::int64_t x) const;
 	// Generates a random double between 0.0f and 1.0f
 	float randf();
+	// Restarts randf from a state that only depends on the seed and the chunk
+	// So a chunk comes out the same whatever got generated before it
+	void seedChunk(const std::int64_t position);
 	std::uint64_t getSeed() const { return mSeed; }
 	void setSeed(std::uint64_t seed) { mSeed = seed; }
 
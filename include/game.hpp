@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <span>
+#include <string>
 
 // TODO: Cleanup this
 class Game {
@@ -25,7 +26,10 @@ class Game {
 		return &instance;
 	}
 
-	void init();
+	// Plays a fresh level recording the input to record, or replaying the input in replay, if given
+	void init(const std::string& record = "", const std::string& replay = "");
+	// A fresh level from the seed, without sound or the save, for rendering without a screen
+	void initHeadless(const std::uint64_t seed);
 	void save();
 
 	[[nodiscard]] SDL_AppResult iterate();
@@ -33,6 +37,7 @@ class Game {
 
 	[[nodiscard]] class LocaleManager* getLocaleManager() const { return mLocaleManager.get(); }
 	[[nodiscard]] class SystemManager* getSystemManager() const { return mSystemManager.get(); }
+	[[nodiscard]] class ReplayManager* getReplayManager() const { return mReplayManager.get(); }
 
 	void setPlayerID(const EntityID id) { mPlayer = id; }
 	[[nodiscard]] EntityID getPlayerID() const { return mPlayer; }
@@ -40,9 +45,11 @@ class Game {
 	class Level* getLevel() const { return mCurrentLevel.get(); }
 
       private:
+	void createManagers();
 	void gui();
 
 	std::unique_ptr<class EventManager> mEventManager;
+	std::unique_ptr<class ReplayManager> mReplayManager;
 
 	std::unique_ptr<class SystemManager> mSystemManager;
 	std::unique_ptr<class LocaleManager> mLocaleManager;
@@ -52,6 +59,10 @@ class Game {
 	std::unique_ptr<class StorageManager> mStorageManager;
 
 	std::uint64_t mTicks;
+	// Time not simulated yet, less than a tick
+	float mAccumulator;
+	// Runs the ticks of a frame while the last one is drawn
+	std::unique_ptr<class Worker> mSimulation;
 	EntityID mPlayer;
 
 	SDL_AudioStream* mStream;
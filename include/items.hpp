@@ -40,6 +40,8 @@ enum class Item : std::uint64_t {
 	IRON_SWORD,
 	WOODEN_SWORD,
 	STONE_SWORD,
+	WATER,
+	LAVA,
 
 	ITEM_COUNT
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "managers/entityManager.hpp"
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Records the input of a session to a file, or plays one back in place of the real input
+// Both start on a fresh level with the seed of the file, the game logic has to take the time and the mouse from here
+// so the replay sees the same ones
+class ReplayManager {
+      public:
+	explicit ReplayManager() noexcept;
+	ReplayManager(ReplayManager&&) = delete;
+	ReplayManager(const ReplayManager&) = delete;
+	ReplayManager& operator=(ReplayManager&&) = delete;
+	ReplayManager& operator=(const ReplayManager&) = delete;
+	~ReplayManager();
+
+	[[nodiscard]] bool record(const std::string& path, const std::uint64_t seed, const int width, const int height);
+	[[nodiscard]] bool replay(const std::string& path);
+
+	[[nodiscard]] bool recording() const { return mMode == Mode::RECORD; }
+	[[nodiscard]] bool replaying() const { return mMode == Mode::REPLAY; }
+	[[nodiscard]] std::uint64_t getSeed() const { return mSeed; }
+	[[nodiscard]] int getWidth() const { return mWidth; }
+	[[nodiscard]] int getHeight() const { return mHeight; }
+	// Replay only, if the last replay ended on the recorded world
+	[[nodiscard]] bool matched() const { return mMatched; }
+
+	// Writes down the input events, false if the event has to be dropped because the replay supplies them
+	[[nodiscard]] bool event(const union SDL_Event& event);
+	// Start of a frame, samples the clock and the mouse or reads them back with the events before them
+	// False once the replay is over
+	[[nodiscard]] bool frame(class EventManager* events);
+	// How long the frame took, replays print them at the end
+	void frameTime(const std::uint64_t ns);
+	// Writes the end of the recording, or checks the end of the replay against the recorded one
+	void finish(class Scene* scene, const EntityID player);
+
+	// Use these instead of SDL_GetTicks and SDL_GetMouseState in the game logic
+	[[nodiscard]] static std::uint64_t getTicks();
+	static SDL_MouseButtonFlags getMouseState(float* x, float* y);
+
+      private:
+	constexpr const static inline std::uint32_t MAGIC = 0x50525943; // CYRP
+	constexpr const static inline std::uint32_t VERSION = 3;
+
+	// Records of the file, a frame is the events since the last one then the frame itself
+	enum Record : std::uint8_t {
+		FRAME = 'F',
+		KEY_DOWN = 'K',
+		KEY_UP = 'k',
+		BUTTON_DOWN = 'B',
+		BUTTON_UP = 'b',
+		RESIZE = 'R',
+		END = 'E',
+	};
+
+	enum class Mode { NONE, RECORD, REPLAY };
+
+	// Hashes of the blocks and the positions of everything, and of the player's position, velocity and items
+	[[nodiscard]] static std::uint64_t hashWorld(class Scene* scene);
+	[[nodiscard]] static std::uint64_t hashPlayer(class Scene* scene, const EntityID player);
+	void close();
+	void report();
+
+	Mode mMode;
+	SDL_IOStream* mFile;
+	std::string mPath;
+
+	std::uint64_t mSeed;
+	int mWidth;
+	int mHeight;
+
+	// State of the current frame
+	std::uint64_t mTicks;
+	float mMouseX;
+	float mMouseY;
+	SDL_MouseButtonFlags mButtons;
+
+	std::uint64_t mFrames;
+	std::vector<std::uint64_t> mTimes;
+	// What the recording ended on
+	struct {
+		std::uint64_t mFrames;
+		std::uint64_t mWorld;
+		std::uint64_t mPlayer;
+	} mExpected;
+	bool mMatched;
+};
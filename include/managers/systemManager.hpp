@@ -1,13 +1,18 @@
 #pragma once
 
+#include "managers/entityManager.hpp"
 #include "systems/textSystem.hpp"
 #include "third_party/Eigen/Core"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class SystemManager {
       public:
+	// 60 simulation ticks per second
+	inline constexpr const static float TICK_LENGTH = 1.0f / 60.0f;
+
 	explicit SystemManager() noexcept;
 	SystemManager(SystemManager&&) = delete;
 	SystemManager(const SystemManager&) = delete;
@@ -15,7 +20,19 @@ class SystemManager {
 	SystemManager& operator=(const SystemManager&) = delete;
 	~SystemManager();
 
-	void update(class Scene* scene, const float delta);
+	// Moves the simulation forward by one tick
+	void tick(class Scene* scene, const float delta);
+	// Once per frame, alpha is how far we are between the last tick and the next
+	// Same as record, submit then endFrame
+	void update(class Scene* scene, const float delta, const float alpha);
+	// Handles the input and takes what gets drawn from the scene, the ticks can run while it's submitted
+	void record(class Scene* scene, const float delta, const float alpha);
+	// Draws what got recorded, only reads the scene when a screen is open
+	void submit(class Scene* scene);
+	// If the screens get drawn this frame, the ticks have to be done before the submit then
+	[[nodiscard]] bool drawsScreens() const { return mDrawScreens; }
+	// After the ticks of the frame
+	void endFrame(class Scene* scene);
 
 	void setDemensions(const int width, const int height);
 
@@ -25,6 +42,7 @@ class SystemManager {
 	[[nodiscard]] class Shader* getShader(const std::string& vert, const std::string& frag,
 					      const std::string& geom = "");
 
+	[[nodiscard]] class PhysicsSystem* getPhysicsSystem() const { return mPhysicsSystem.get(); }
 	[[nodiscard]] class UISystem* getUISystem() const { return mUISystem.get(); }
 	[[nodiscard]] class TextSystem* getTextSystem() const { return mTextSystem.get(); }
 	[[nodiscard]] class RenderSystem* getRenderSystem() const { return mRenderSystem.get(); }
@@ -32,6 +50,9 @@ class SystemManager {
       private:
 	void printDebug(class Scene* scene);
 	void updatePlayer(class Scene* scene);
+	// Moves the moving entities between where they were before and after the last tick, restore puts them back
+	void interpolate(class Scene* scene, const float alpha);
+	void restore(class Scene* scene);
 
 	// The order of the systems shall be listed by the order they are updated
 	std::unique_ptr<class PhysicsSystem> mPhysicsSystem;
@@ -39,4 +60,13 @@ class SystemManager {
 	std::unique_ptr<class InputSystem> mInputSystem;
 	std::unique_ptr<class TextSystem> mTextSystem;
 	std::unique_ptr<class UISystem> mUISystem;
+
+	struct Interpolated {
+		EntityID mEntity;
+		Eigen::Vector2f mPrevious;
+		Eigen::Vector2f mCurrent;
+	};
+
+	std::vector<Interpolated> mInterpolated;
+	bool mDrawScreens;
 };
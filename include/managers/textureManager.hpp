@@ -1,11 +1,10 @@
 #pragma once
 
-#include "items.hpp"
-#include "third_party/glad/glad.h"
+#include "third_party/Eigen/Core"
 
-#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class TextureManager {
       public:
@@ -16,18 +15,33 @@ class TextureManager {
 	TextureManager& operator=(const TextureManager&) = delete;
 	~TextureManager();
 
+	// Where a texture is in the atlas, packed at build time by cmake/atlas.py
+	struct Region {
+		class Texture* mPage;
+		// Corner and size in texture coordinates
+		Eigen::Vector4f mUV;
+	};
+
 	class Texture* get(const std::string& name, const bool srgb = true);
 
-	class Texture* getAtlas();
-	void blitzAtlas(Components::Item block);
+	// First page of the atlas, where the blocks are
+	class Texture* getAtlas() const { return mPages.empty() ? nullptr : mPages.front(); }
+	// nullptr if the texture isn't in the atlas
+	[[nodiscard]] const Region* getRegion(const std::string& name) const;
+	[[nodiscard]] const Region* getRegion(const class Texture* texture) const;
 
 	void reload();
 
       private:
+	inline constexpr const static char* const ATLAS_FILE = "atlas.json";
+
+	void loadAtlas();
+
 	const std::string mPath;
 
 	std::unordered_map<std::string, class Texture*> mTextures;
-	std::unique_ptr<bool[]> mBlitzed;
-	class Texture* mAtlas;
-	GLuint mAtlasBuffer;
+	std::vector<class Texture*> mPages;
+	std::unordered_map<std::string, Region> mRegions;
+	// The loaded textures that are also in the atlas
+	std::unordered_map<const class Texture*, const Region*> mTextureRegions;
 };
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "third_party/Eigen/Core"
+
+#include <algorithm>
+
+// Integration of many bodies at once
+// The bodies are stored as columns, one array per value, so Eigen runs the math on whole packets of bodies
+namespace integration {
+struct Columns {
+	Eigen::ArrayXf mPositionX;
+	Eigen::ArrayXf mPositionY;
+	Eigen::ArrayXf mVelocityX;
+	Eigen::ArrayXf mVelocityY;
+	// 1 if the body stands on something, 0 otherwise
+	Eigen::ArrayXf mGrounded;
+	// Bodies in use, the arrays can be longer
+	Eigen::Index mSize = 0;
+
+	// The values are undefined after, the storage only ever grows so ticks don't allocate
+	void resize(const Eigen::Index size) {
+		mSize = size;
+		if (size <= mVelocityX.size()) {
+			return;
+		}
+
+		const Eigen::Index capacity = std::max<Eigen::Index>(size, mVelocityX.size() * 2);
+		mPositionX.resize(capacity);
+		mPositionY.resize(capacity);
+		mVelocityX.resize(capacity);
+		mVelocityY.resize(capacity);
+		mGrounded.resize(capacity);
+	}
+};
+
+// Pulls down the bodies that aren't on the ground
+inline void gravity(Columns& columns, const float g, const float delta) {
+	const Eigen::Index size = columns.mSize;
+	columns.mVelocityY.head(size) -= (1.0f - columns.mGrounded.head(size)) * (g * delta);
+}
+
+inline void friction(Columns& columns, const float factor) { columns.mVelocityX.head(columns.mSize) *= factor; }
+
+// Moves the bodies without looking at what's in the way
+inline void move(Columns& columns, const float delta) {
+	const Eigen::Index size = columns.mSize;
+	columns.mPositionX.head(size) += columns.mVelocityX.head(size) * delta;
+	columns.mPositionY.head(size) += columns.mVelocityY.head(size) * delta;
+}
+} // namespace integration
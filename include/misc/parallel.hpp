@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+// Splitting loops between threads
+// The ranges only depend on the count and the thread count, work that doesn't share state between items gives the
+// same result no matter how it's split
+namespace parallel {
+// Threads a loop may use, the web build runs everything on the main thread
+[[nodiscard]] inline std::size_t threads() {
+#ifdef __EMSCRIPTEN__
+	return 1;
+#else
+	return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+#endif
+}
+
+// Threads kept around for the loops, starting new ones every loop costs about as much as the work they split
+// The thread calling forRanges takes a range too, so there's one thread less than count
+class Pool {
+      public:
+	explicit Pool(const std::size_t count = threads()) : mFunc(nullptr), mCall(nullptr), mQuit(false) {
+		const std::size_t helpers = std::max<std::size_t>(count, 1) - 1;
+
+		mThreads.reserve(helpers);
+		for (std::size_t i = 0; i < helpers; ++i) {
+			Thread& thread = *mThreads.emplace_back(std::make_unique<Thread>());
+
+			thread.mThread = std::jthread([this, &thread]() {
+				while (true) {
+					thread.mStart.acquire();
+					if (mQuit) {
+						return;
+					}
+
+					mCall(mFunc, thread.mBegin, thread.mEnd);
+					thread.mDone.release();
+				}
+			});
+		}
+	}
+	Pool(Pool&&) = delete;
+	Pool(const Pool&) = delete;
+	Pool& operator=(Pool&&) = delete;
+	Pool& operator=(const Pool&) = delete;
+	~Pool() {
+		// Set before the release, the semaphore orders it
+		mQuit = true;
+		for (const auto& thread : mThreads) {
+			thread->mStart.release();
+		}
+	}
+
+	// Calls func(begin, end) over [0, count) in ranges of at least grain items and waits for all of them
+	template <typename Func> void forRanges(const std::size_t count, const std::size_t grain, const Func& func) {
+		const std::size_t workers =
+			std::clamp<std::size_t>(count / std::max<std::size_t>(grain, 1), 1, mThreads.size() + 1);
+		if (workers == 1) {
+			func(0, count);
+
+			return;
+		}
+
+		// No std::function, handing out the ranges doesn't allocate
+		mFunc = &func;
+		mCall = [](const void* const f, const std::size_t begin, const std::size_t end) {
+			(*static_cast<const Func*>(f))(begin, end);
+		};
+
+		const std::size_t step = (count + workers - 1) / workers;
+		std::size_t started = 0;
+		for (std::size_t begin = step; begin < count; begin += step) {
+			Thread& thread = *mThreads[started++];
+			thread.mBegin = begin;
+			thread.mEnd = std::min(begin + step, count);
+			thread.mStart.release();
+		}
+
+		func(0, std::min(step, count));
+
+		// Everything the threads wrote is visible after
+		for (std::size_t i = 0; i < started; ++i) {
+			mThreads[i]->mDone.acquire();
+		}
+	}
+
+	// Including the calling thread
+	[[nodiscard]] std::size_t size() const { return mThreads.size() + 1; }
+
+      private:
+	struct Thread {
+		std::binary_semaphore mStart{0};
+		std::binary_semaphore mDone{0};
+		std::size_t mBegin = 0;
+		std::size_t mEnd = 0;
+
+		std::jthread mThread;
+	};
+
+	// The loop being run, only written while the threads wait on mStart
+	const void* mFunc;
+	void (*mCall)(const void* func, const std::size_t begin, const std::size_t end);
+	bool mQuit;
+
+	std::vector<std::unique_ptr<Thread>> mThreads;
+};
+} // namespace parallel
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "third_party/Eigen/Core"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Continuous collision of a moving box against the boxes of a tile grid
+// The move is done one axis at a time, Y first so a fall lands before the box slides. Every axis stops at the first
+// box in the way, so fast boxes can't skip over thin floors. Boxes the mover already overlaps are ignored, that way
+// it can still get out of them
+namespace sweep {
+struct Result {
+	// Lower corner of the box after the move
+	Eigen::Vector2f mPosition;
+	// Fraction of the move done on every axis before hitting something, 1 if nothing got hit
+	Eigen::Vector2f mTime;
+	bool mHitX;
+	bool mHitY;
+};
+
+// Closer than this counts as touching
+inline constexpr const static float EPSILON = 0.01f;
+
+// boxes(x, y, visit) has to call visit(min, max) for the collision box in the tile (x, y), if there is one
+template <typename Boxes>
+float moveAxis(const int axis, Eigen::Vector2f& min, const Eigen::Vector2f& size, const float distance,
+	       const float tileSize, Boxes&& boxes) {
+	if (distance == 0) {
+		return 0;
+	}
+
+	const int other = 1 - axis;
+	const Eigen::Vector2f max = min + size;
+
+	// The tiles swept over, the boxes don't leave their tile
+	const auto tile = [tileSize](const float position) {
+		return static_cast<std::int64_t>(std::floor(position / tileSize));
+	};
+	const std::int64_t first = tile(distance > 0 ? max[axis] : min[axis] + distance);
+	const std::int64_t last = tile(distance > 0 ? max[axis] + distance : min[axis]);
+	const std::int64_t firstOther = tile(min[other]);
+	const std::int64_t lastOther = tile(max[other]);
+
+	float allowed = distance;
+	for (std::int64_t i = first; i <= last; ++i) {
+		for (std::int64_t j = firstOther; j <= lastOther; ++j) {
+			const std::int64_t x = axis == 0 ? i : j;
+			const std::int64_t y = axis == 0 ? j : i;
+
+			boxes(x, y, [&](const Eigen::Vector2f& boxMin, const Eigen::Vector2f& boxMax) {
+				// Only touching on the other axis
+				if (boxMax[other] <= min[other] || boxMin[other] >= max[other]) {
+					return;
+				}
+
+				if (distance > 0) {
+					// Already inside or behind
+					if (boxMin[axis] < max[axis] - EPSILON) {
+						return;
+					}
+
+					allowed = std::min(allowed, std::max(boxMin[axis] - max[axis], 0.0f));
+				} else {
+					if (boxMax[axis] > min[axis] + EPSILON) {
+						return;
+					}
+
+					allowed = std::max(allowed, std::min(boxMax[axis] - min[axis], 0.0f));
+				}
+			});
+		}
+	}
+
+	min[axis] += allowed;
+
+	return allowed;
+}
+
+template <typename Boxes>
+Result move(const Eigen::Vector2f& min, const Eigen::Vector2f& size, const Eigen::Vector2f& distance,
+	    const float tileSize, Boxes&& boxes) {
+	Result result{min, Eigen::Vector2f(1.0f, 1.0f), false, false};
+
+	const float y = moveAxis(1, result.mPosition, size, distance.y(), tileSize, boxes);
+	const float x = moveAxis(0, result.mPosition, size, distance.x(), tileSize, boxes);
+
+	if (y != distance.y()) {
+		result.mHitY = true;
+		result.mTime.y() = y / distance.y();
+	}
+
+	if (x != distance.x()) {
+		result.mHitX = true;
+		result.mTime.x() = x / distance.x();
+	}
+
+	return result;
+}
+} // namespace sweep
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <semaphore>
+#include <thread>
+#include <utility>
+
+// A thread running one job at a time next to the one that started it
+// The web build has no threads, the job runs right away there
+class Worker {
+      public:
+	explicit Worker() : mJob(nullptr), mStart(0), mDone(0), mBusy(false), mQuit(false) {
+#ifndef __EMSCRIPTEN__
+		mThread = std::jthread([this]() {
+			while (true) {
+				mStart.acquire();
+				if (mQuit) {
+					return;
+				}
+
+				mJob();
+				mDone.release();
+			}
+		});
+#endif
+	}
+	Worker(Worker&&) = delete;
+	Worker(const Worker&) = delete;
+	Worker& operator=(Worker&&) = delete;
+	Worker& operator=(const Worker&) = delete;
+	~Worker() {
+		wait();
+
+#ifndef __EMSCRIPTEN__
+		mQuit = true;
+		mStart.release();
+#endif
+	}
+
+	// Waits for the last job before starting this one
+	void run(std::function<void()> job) {
+		wait();
+
+		mJob = std::move(job);
+#ifdef __EMSCRIPTEN__
+		mJob();
+#else
+		mBusy = true;
+		mStart.release();
+#endif
+	}
+
+	// Blocks until the job is done, everything it wrote is visible after
+	void wait() {
+		if (mBusy) {
+			mDone.acquire();
+			mBusy = false;
+		}
+	}
+
+      private:
+	std::function<void()> mJob;
+	std::binary_semaphore mStart;
+	std::binary_semaphore mDone;
+	// Only touched by the thread that runs the jobs
+	bool mBusy;
+	// Set before the last release of mStart, the semaphore orders it
+	bool mQuit;
+
+	std::jthread mThread;
+};
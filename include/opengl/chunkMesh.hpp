@@ -0,0 +1,36 @@
+#pragma once
+
+#include "third_party/glad/glad.h"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Block instances of a loaded chunk, they stay on the GPU between frames
+// An update only uploads the instances that differ from the last one, with the same layout a block change is a patch
+class ChunkMesh {
+      public:
+	// Position, type and light
+	using Instance = std::array<GLint, 4>;
+
+	explicit ChunkMesh();
+	ChunkMesh(ChunkMesh&&) = delete;
+	ChunkMesh(const ChunkMesh&) = delete;
+	ChunkMesh& operator=(ChunkMesh&&) = delete;
+	ChunkMesh& operator=(const ChunkMesh&) = delete;
+	~ChunkMesh();
+
+	void update(const std::span<const Instance> instances);
+	void draw(class Mesh* mesh) const;
+
+	[[nodiscard]] std::size_t size() const { return mInstances.size(); }
+
+      private:
+	GLuint mBuffer;
+	// In instances
+	std::size_t mCapacity;
+
+	// What the GPU has
+	std::vector<Instance> mInstances;
+};
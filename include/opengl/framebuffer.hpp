@@ -2,7 +2,9 @@
 
 #include "third_party/glad/glad.h"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class Framebuffer {
   public:
@@ -17,11 +19,17 @@ class Framebuffer {
 	void swap();
 	void bind() const;
 
+	// What the last frame drew, RGBA rows from the top
+	[[nodiscard]] std::vector<std::uint8_t> read() const;
+	[[nodiscard]] int getWidth() const { return mWidth; }
+	[[nodiscard]] int getHeight() const { return mHeight; }
+
   private:
 	class RenderSystem* mOwner;
 
 	GLuint mScreen;
 	GLuint mScreenTexture;
+	int mWidth, mHeight;
 
 	std::unique_ptr<class Mesh> mScreenMesh;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "third_party/glad/glad.h"
+
+#include <array>
+#include <cstddef>
+
+// Remembers the bound program, textures, vertex array and blending, changes to what's already there are skipped
+// Everything binding those has to go through here or call invalidate, or the cache goes out of sync with GL
+class GLState {
+      public:
+	struct Stats {
+		std::size_t mDrawCalls;
+		std::size_t mPrograms;
+		std::size_t mTextures;
+		std::size_t mVertexArrays;
+		std::size_t mBlends;
+		// Changes that didn't go to GL since they were already set
+		std::size_t mSkipped;
+
+		[[nodiscard]] std::size_t stateChanges() const {
+			return mPrograms + mTextures + mVertexArrays + mBlends;
+		}
+	};
+
+	GLState() = delete;
+
+	static void useProgram(const GLuint program);
+	static void bindTexture(const GLuint unit, const GLuint texture);
+	static void bindVertexArray(const GLuint vertexArray);
+	static void blend(const bool enabled);
+	static void blendFunc(const GLenum source, const GLenum destination);
+	static void countDraw() { ++mStats.mDrawCalls; }
+
+	// Forget everything, for after something else touched GL or a bound object got deleted
+	static void invalidate();
+
+	// Counters since the last reset, reset at the start of every frame
+	[[nodiscard]] static const Stats& getStats() { return mStats; }
+	static void resetStats() { mStats = {}; }
+
+      private:
+	constexpr const static inline std::size_t TEXTURE_UNITS = 16;
+	// Never a valid name, so the first bind always goes through
+	constexpr const static inline GLuint UNKNOWN = ~0u;
+
+	static inline Stats mStats = {};
+
+	static inline GLuint mProgram = UNKNOWN;
+	static inline GLuint mActiveUnit = UNKNOWN;
+	static inline std::array<GLuint, TEXTURE_UNITS> mTextures = {};
+	static inline GLuint mVertexArray = UNKNOWN;
+	// 0 or 1, UNKNOWN if it wasn't set since the last invalidate
+	static inline GLuint mBlend = UNKNOWN;
+	static inline GLenum mBlendSource = UNKNOWN;
+	static inline GLenum mBlendDestination = UNKNOWN;
+};
@@ -33,6 +33,8 @@ class Mesh {
 	void addTexture(const std::pair<Texture* const, TextureType> texture) { mTextures.emplace_back(texture); }
 	void addAttribArray(const GLsizeiptr size, const GLvoid* const data, void (*bind)());
 	void addAttribArray(const GLuint VBO, void (*bind)());
+	// Points the attributes at offset in a buffer the mesh doesn't own, for buffers moving their data around
+	void bindAttribArray(const GLuint VBO, const GLintptr offset, void (*bind)(GLintptr offset));
 
       private:
 	GLuint mVBO;
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "third_party/glad/glad.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CPU and GPU time of every pass of a frame
+// The GPU time comes from timer queries read back a few frames later, so reading them never waits for the GPU
+// Without timer queries (GLES without EXT_disjoint_timer_query) the GPU time can be measured by finishing the GL
+// commands at the end of every pass instead, that stalls so it's off until turned on
+class Profiler {
+      public:
+	// In the order they're drawn
+	enum class Pass : std::uint8_t {
+		// Rebuilding the changed chunks and the atlas rects
+		UPLOAD,
+		BLOCKS,
+		// The textures and the animations, batched together
+		SPRITES,
+		HUD,
+		TEXT,
+		UI,
+		// The framebuffer to the screen, ImGui and the swap
+		PRESENT,
+		COUNT,
+	};
+
+	constexpr const static inline std::size_t PASSES = static_cast<std::size_t>(Pass::COUNT);
+	using Times = std::array<std::uint64_t, PASSES>;
+
+	explicit Profiler();
+	Profiler(Profiler&&) = delete;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(Profiler&&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+	~Profiler();
+
+	// Start of a frame, reads back the queries that are done
+	void frame();
+	// Times the work after this as the pass, until the next one begins or end
+	void begin(const Pass pass);
+	void end();
+
+	// In ns, of the last frame
+	[[nodiscard]] const Times& getCPUTimes() const { return mCPU; }
+	// In ns, of the newest frame read back, LATENCY frames old
+	[[nodiscard]] const Times& getGPUTimes() const { return mGPU; }
+	// If there are GPU times, from the queries or finishing every pass
+	[[nodiscard]] bool hasGPUTimes() const { return mTimerQueries || mFinish; }
+	[[nodiscard]] static const char* getName(const Pass pass);
+
+	// Writes the times of the last HISTORY frames as csv, in us
+	[[nodiscard]] bool save(const std::string& path) const;
+	// The overlay, in the developer menu
+	void gui();
+
+      private:
+	// Frames of queries in flight, a query gets read back this many frames after
+	constexpr const static inline std::size_t LATENCY = 4;
+	// Frames kept for the overlay and save
+	constexpr const static inline std::size_t HISTORY = 300;
+
+	struct Sample {
+		std::uint64_t mFrame;
+		Times mCPU;
+		Times mGPU;
+	};
+
+	// Queries of a frame, a pass can be timed more than once in a frame
+	struct Slot {
+		std::uint64_t mFrame;
+		std::vector<GLuint> mQueries;
+		std::vector<Pass> mPasses;
+	};
+
+	void readBack(Slot& slot);
+	// The sample of the frame, nullptr if it's out of the history
+	[[nodiscard]] Sample* getSample(const std::uint64_t frame);
+
+	bool mTimerQueries;
+	// Measure the GPU by finishing every pass, when there are no timer queries
+	bool mFinish;
+
+	std::uint64_t mFrame;
+	std::array<Slot, LATENCY> mSlots;
+
+	Pass mPass;
+	std::uint64_t mStart;
+
+	Times mCPU;
+	Times mGPU;
+	// Of the frame being drawn
+	Times mCurrentCPU;
+	Times mCurrentGPU;
+
+	std::vector<Sample> mHistory;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "third_party/Eigen/Core"
+#include "third_party/glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <variant>
+#include <vector>
+
+// Draws of a mesh submitted over a frame then drawn at once, sorted so the same shader, texture and mesh end up back
+// to back and the state cache can skip the binds
+// Sorted by pass, then layer, then state. Layers order the draws that overlap inside of a pass, draws with the same
+// layer and state keep the order they were submitted in
+class RenderQueue {
+      public:
+	enum class Pass : std::uint8_t {
+		HUD,
+		TEXT,
+		// Screens draw immediately, they flush after submitting
+		UI,
+	};
+
+	// Sets the uniforms of the last submitted draw
+	class Submission {
+	      public:
+		Submission& set(const std::uint64_t name, const GLint value);
+		Submission& set(const std::uint64_t name, const GLfloat value);
+		Submission& set(const std::uint64_t name, const GLfloat value, const GLfloat value2);
+		Submission& set(const std::uint64_t name, const Eigen::Vector2f& value);
+		Submission& set(const std::uint64_t name, const Eigen::Vector3f& value);
+
+	      private:
+		friend class RenderQueue;
+
+		explicit Submission(RenderQueue* queue) : mQueue(queue) {}
+
+		RenderQueue* mQueue;
+	};
+
+	explicit RenderQueue();
+	RenderQueue(RenderQueue&&) = delete;
+	RenderQueue(const RenderQueue&) = delete;
+	RenderQueue& operator=(RenderQueue&&) = delete;
+	RenderQueue& operator=(const RenderQueue&) = delete;
+	~RenderQueue();
+
+	// Blended draws use the usual alpha blending
+	Submission submit(const Pass pass, const int layer, class Shader* const shader,
+			  const class Texture* const texture, class Mesh* const mesh, const bool blend = false);
+	// Draws everything submitted and clears the queue, calls passBegin before the first draw of every pass
+	void flush(const std::function<void(Pass)>& passBegin = nullptr);
+
+	[[nodiscard]] bool empty() const { return mCommands.empty(); }
+
+      private:
+	struct Uniform {
+		std::uint64_t mName;
+		std::variant<GLint, GLfloat, Eigen::Vector2f, Eigen::Vector3f> mValue;
+	};
+
+	struct Command {
+		Pass mPass;
+		int mLayer;
+		class Shader* mShader;
+		const class Texture* mTexture;
+		class Mesh* mMesh;
+		bool mBlend;
+
+		// Order of submission, keeps the sort stable
+		std::size_t mSequence;
+		// Range in mUniforms
+		std::size_t mFirstUniform;
+		std::size_t mUniforms;
+	};
+
+	std::vector<Command> mCommands;
+	// Uniforms of all the commands, kept between frames to not reallocate
+	std::vector<Uniform> mUniforms;
+};
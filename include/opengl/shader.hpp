@@ -3,11 +3,13 @@
 #include "third_party/Eigen/Dense"
 #include "third_party/glad/glad.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 constexpr const static unsigned int crc_table[256] = {
 	0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3, 0x0edb8832,
@@ -61,6 +63,54 @@ template <hash_value v> consteval std::uint64_t operator""_u() { return v.hash;
 
 std::uint64_t crc32(const char* str, std::size_t len);
 
+// Every uniform the shaders have gets a slot, set() finds its location in an array instead of a map
+// Add new uniforms here, the ones without a slot still work but get looked up
+enum class UniformSlot : std::uint8_t {
+	OFFSET,
+	SIZE,
+	SCALE,
+	POSITION,
+	PERCENT,
+	VERTICAL,
+	WIREFRAME,
+	TEXTURE_DIFFUSE,
+	LETTER,
+	TEXT_COLOR,
+	SCREEN,
+
+	COUNT,
+	NONE = COUNT,
+};
+
+constexpr UniformSlot uniformSlot(const std::uint64_t name) {
+	switch (name) {
+		case "offset"_u:
+			return UniformSlot::OFFSET;
+		case "size"_u:
+			return UniformSlot::SIZE;
+		case "scale"_u:
+			return UniformSlot::SCALE;
+		case "position"_u:
+			return UniformSlot::POSITION;
+		case "percent"_u:
+			return UniformSlot::PERCENT;
+		case "vertical"_u:
+			return UniformSlot::VERTICAL;
+		case "wireframe"_u:
+			return UniformSlot::WIREFRAME;
+		case "texture_diffuse"_u:
+			return UniformSlot::TEXTURE_DIFFUSE;
+		case "letter"_u:
+			return UniformSlot::LETTER;
+		case "textColor"_u:
+			return UniformSlot::TEXT_COLOR;
+		case "screen"_u:
+			return UniformSlot::SCREEN;
+		default:
+			return UniformSlot::NONE;
+	}
+}
+
 class Shader {
       public:
 	Shader();
@@ -93,11 +143,21 @@ class Shader {
       private:
 	[[nodiscard]] static GLuint compile(std::string_view fileName, GLenum type);
 
-	GLint getUniform(std::uint64_t name) const;
+	GLint getUniform(const std::uint64_t name) const {
+		const UniformSlot slot = uniformSlot(name);
+		[[likely]] if (slot != UniformSlot::NONE) { return mLocations[static_cast<std::size_t>(slot)]; }
+
+		return getOtherUniform(name);
+	}
+	GLint getOtherUniform(const std::uint64_t name) const;
 
 	std::string mName;
 	const GLuint mShaderProgram;
 
-	// Cache
-	mutable std::unordered_map<std::uint64_t, GLint> mPositionCache;
+	// Filled when linking, -1 for the uniforms this shader doesn't have so setting them does nothing
+	std::array<GLint, static_cast<std::size_t>(UniformSlot::COUNT)> mLocations;
+	// Uniforms without a slot
+	std::vector<std::pair<std::uint64_t, GLint>> mOtherLocations;
+	// Hashes already warned about
+	mutable std::vector<std::uint64_t> mMissing;
 };
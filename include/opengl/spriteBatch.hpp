@@ -0,0 +1,47 @@
+#pragma once
+
+#include "third_party/Eigen/Core"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Collects textured quads over a frame and draws them instanced, a draw per texture
+// Sprites are sorted by layer then texture, the order inside of a layer isn't kept between textures
+class SpriteBatch {
+      public:
+	explicit SpriteBatch();
+	SpriteBatch(SpriteBatch&&) = delete;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(SpriteBatch&&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+	~SpriteBatch();
+
+	// Position and size in pixels, uv is the corner and the size of the region of the texture, flipped if negative
+	void add(const class Texture* const texture, const int layer, const Eigen::Vector2f& position,
+		 const Eigen::Vector2f& size, const Eigen::Vector4f& uv);
+	// Draws and clears the sprites, the shader has to be active
+	void draw();
+
+	[[nodiscard]] std::size_t getDrawCalls() const { return mDrawCalls; }
+
+      private:
+	// Position and size, then the uv
+	using Instance = std::array<float, 8>;
+
+	struct Sprite {
+		const class Texture* mTexture;
+		int mLayer;
+		Instance mInstance;
+	};
+
+	std::vector<Sprite> mSprites;
+	// Sorted instances, kept between frames to not reallocate
+	std::vector<Instance> mInstances;
+	std::size_t mDrawCalls;
+
+	std::unique_ptr<class StreamBuffer> mBuffer;
+	// Has its own vertex array, the instance attributes don't mix with the blocks'
+	std::unique_ptr<class Mesh> mMesh;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "third_party/glad/glad.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Vertex buffer rewritten every frame, split in regions used one after the other so we never write into data the GPU
+// may still be reading. The storage only gets reallocated when the data outgrows it
+class StreamBuffer {
+      public:
+	explicit StreamBuffer(const GLsizeiptr capacity);
+	StreamBuffer(StreamBuffer&&) = delete;
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(StreamBuffer&&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+	~StreamBuffer();
+
+	// Copies the data to the next region, false without touching the GPU if it's the same as the last upload
+	bool upload(const void* const data, const GLsizeiptr size);
+
+	[[nodiscard]] GLuint getBuffer() const { return mBuffer; }
+	// Where the last upload went, the attribute pointers have to start there
+	[[nodiscard]] GLintptr getOffset() const { return mOffset; }
+
+      private:
+	constexpr const static inline std::size_t REGIONS = 3;
+
+	// Orphans the storage for bigger regions
+	void grow(const GLsizeiptr size);
+
+	GLuint mBuffer;
+	// Size of a region
+	GLsizeiptr mCapacity;
+	std::size_t mRegion;
+	GLintptr mOffset;
+	// Set once the GPU got the draws of a region
+	std::array<GLsync, REGIONS> mFences;
+
+	// Copy of the last upload to skip the same data
+	std::vector<std::byte> mLast;
+};
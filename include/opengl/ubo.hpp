@@ -13,6 +13,7 @@ class UBO {
 	~UBO();
 
 	void set(GLintptr name, const Eigen::Affine3f& matrix) const;
+	void set(GLintptr offset, GLsizeiptr size, const void* data) const;
 	void bind(GLuint index) const;
 
       private:
@@ -16,6 +16,8 @@ enum class Item : std::uint64_t;
 consteval inline static auto AIR() { return static_cast<Item>(0); }
 } // namespace Components
 
+class Level;
+
 namespace registers {
 enum class MiningSystem;
 
@@ -61,6 +63,18 @@ extern const std::vector<std::string> BACKGROUND_SOUNDS;
 // Size 0x0 is no collision box
 extern const std::unordered_map<Components::Item, std::pair<Eigen::Vector2f, Eigen::Vector2f>> COLLISION_BOXES;
 
+// Light emitted by blocks, from 1 to 15
+extern const std::unordered_map<Components::Item, std::uint8_t> LIGHT_LEVELS;
+
+// Blocks with scheduled ticks, map to {delay of the first tick once placed or loaded in game ticks, 0 if something
+// else has to schedule it, tick function}. The tick function returns the delay until the next tick, 0 to stop
+extern const std::unordered_map<Components::Item,
+				std::pair<std::uint64_t, std::uint64_t (*)(Level*, const Eigen::Vector2i&)>>
+	SCHEDULED_TICKS;
+
+// Blocks that do something when they get a random tick
+extern const std::unordered_map<Components::Item, void (*)(Level*, const Eigen::Vector2i&)> RANDOM_TICKS;
+
 // Vector of {chance, min y, ore type and count}
 extern const std::vector<std::tuple<float, std::uint64_t, Components::Item, std::uint64_t>> VEINS;
 } // namespace registers
@@ -59,6 +59,14 @@ class Scene {
 		markAllCachesDirty();
 	}
 
+	// Removes a component from an entity
+	template <typename Component> void remove(const EntityID entity) noexcept {
+		static auto* const pool = ComponentManager::getInstance()->getPool<Component>();
+
+		pool->erase(entity);
+		markAllCachesDirty();
+	}
+
 	template <typename Component> [[nodiscard]] Component& get(const EntityID entity) const {
 		return ComponentManager::getInstance()->getPool<Component>()->get(entity);
 	}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "components.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/rapidjson/document.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Block ticks of the loaded chunks
+// Scheduled ticks sit in a timing wheel, so a game tick only looks at the events that are due. On top of that every
+// section of a loaded chunk gets a few random ticks. Unloaded chunks keep their pending events and catch up on what
+// they missed when they're loaded again
+class BlockTicker {
+      public:
+	// 20 game ticks per second
+	inline constexpr const static float TICK_LENGTH = 0.05f;
+	inline constexpr const static int SECTION_HEIGHT = 16;
+	// Random ticks per section per game tick
+	inline constexpr const static int RANDOM_TICK_SPEED = 3;
+	// Leaves further than this from a log decay
+	inline constexpr const static int DECAY_RANGE = 4;
+
+	explicit BlockTicker(class Level* level);
+	BlockTicker(BlockTicker&&) = delete;
+	BlockTicker(const BlockTicker&) = delete;
+	BlockTicker& operator=(BlockTicker&&) = delete;
+	BlockTicker& operator=(const BlockTicker&) = delete;
+	~BlockTicker() = default;
+
+	// The chunk gets set up on the next tick, once the level can see it
+	void addChunk(const std::int64_t position);
+	// Parks the pending events of the chunk until it gets loaded again
+	void removeChunk(const std::int64_t position);
+	void clear();
+
+	void load(const rapidjson::Value& data);
+	// Only the tick count and when the chunks got unloaded, pending events get rescheduled from the tiles
+	void save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& allocator) const;
+
+	// Tick the block at pos in delay game ticks, dropped if the block has changed by then
+	void schedule(const Eigen::Vector2i& pos, const Components::Item type, const std::uint64_t delay);
+	// A block of a loaded chunk changed, starts its own ticks and the ones of the blocks depending on it
+	void blockChanged(const Eigen::Vector2i& pos, const Components::Item from, const Components::Item to);
+	void tick();
+
+	[[nodiscard]] std::uint64_t getTick() const { return mTick; }
+
+      private:
+	inline constexpr const static std::size_t WHEEL_SIZE = 256;
+	// Random ticks a block gets at most when catching up
+	inline constexpr const static std::uint64_t MAX_CATCH_UP = 4;
+	inline constexpr const static char* const TICK_KEY = "tick";
+	inline constexpr const static char* const PARKED_KEY = "parked";
+
+	struct Event {
+		Eigen::Vector2i mPos;
+		Components::Item mType;
+		std::uint64_t mDue;
+	};
+
+	struct Parked {
+		std::uint64_t mUnloaded;
+		std::vector<Event> mEvents;
+		// Loaded from a save, the events have to be found again
+		bool mScan;
+	};
+
+	void insert(const Event& event);
+	// Reschedules the parked events and runs the random ticks the chunk missed
+	void catchUp(const std::int64_t position, Parked& parked);
+	void randomTick(const Eigen::Vector2i& pos);
+
+	class Level* const mLevel;
+	std::uint64_t mTick;
+
+	// Slot due % WHEEL_SIZE holds the events due in the next WHEEL_SIZE ticks
+	std::array<std::vector<Event>, WHEEL_SIZE> mWheel;
+	// Too far ahead for the wheel, moved in when it comes around
+	std::vector<Event> mLater;
+	// Swapped with the current slot, so handlers can schedule while we walk it
+	std::vector<Event> mDue;
+
+	std::vector<std::int64_t> mLoaded;
+	std::unordered_map<std::int64_t, Parked> mPending;
+	std::unordered_map<std::int64_t, Parked> mParked;
+};
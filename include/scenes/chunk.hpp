@@ -1,20 +1,63 @@
 #pragma once
 
 #include "components.hpp"
+#include "managers/entityManager.hpp"
 #include "third_party/rapidjson/document.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
 
 class Chunk {
       public:
 	inline constexpr const static int MAX_HEIGHT = 128;
 	inline constexpr const static int CHUNK_WIDTH = 16;
 	inline constexpr const static int WATER_LEVEL = 16;
+	// Height of a column without any solid block
+	inline constexpr const static std::int64_t NO_SURFACE = std::numeric_limits<std::int64_t>::min();
+
+	// Tiles of a loaded chunk, column major (x * MAX_HEIGHT + y). Blocks outside of 0..MAX_HEIGHT aren't tracked
+	using Grid = std::array<Components::Item, CHUNK_WIDTH * MAX_HEIGHT>;
+
+	// Output of the generation step, doesn't touch the scene or the GPU
+	struct Tiles {
+		// Indexed by x and then y
+		std::vector<std::vector<Components::Item>> mGrid;
+		// Structure blocks that landed outside of the chunk, in world coordinates
+		std::vector<std::pair<Components::Item, Eigen::Vector2i>> mOverflow;
+		// Top solid tile of every column
+		std::array<std::int64_t, CHUNK_WIDTH> mHeightMap;
+	};
+
+	// Compact form of an unloaded chunk: palette plus column major RLE of the tiles
+	struct Packed {
+		std::int64_t mPosition;
+		// Lowest y and height of the packed area
+		std::int64_t mBottom;
+		std::uint64_t mHeight;
+		std::vector<Components::Item> mPalette;
+		// Run length in the upper bits, palette index in the lower 8 bits
+		std::vector<std::uint32_t> mRuns;
+		std::array<std::int64_t, CHUNK_WIDTH> mHeightMap;
+
+		[[nodiscard]] std::size_t getSize() const {
+			return sizeof(Packed) + mPalette.size() * sizeof(Components::Item) +
+			       mRuns.size() * sizeof(std::uint32_t);
+		}
+	};
+
+	// Generate the tiles of a chunk, deterministic for a given noise state
+	[[nodiscard]] static Tiles generate(class NoiseGenerator* const noise, const std::int64_t position);
 
 	// Generate a chunk from scratch
 	explicit Chunk(class Scene* scene, class NoiseGenerator* const noise, const std::int64_t position);
 	// Load from json
 	explicit Chunk(const rapidjson::Value& data, class Scene* scene);
+	// Load from the chunk cache
+	explicit Chunk(const Packed& data, class Scene* scene);
 
 	Chunk(Chunk&&) = delete;
 	Chunk(const Chunk&) = delete;
@@ -23,20 +66,58 @@ class Chunk {
 	~Chunk() = default;
 
 	void save(class Scene* scene, rapidjson::Value& chunk, rapidjson::MemoryPoolAllocator<>& allocator);
+	// Save into the packed form, removes the blocks from the scene like the json save
+	void save(class Scene* scene, Packed& chunk);
+	// Write a packed chunk as json, for the chunks evicted from the cache
+	static void save(const Packed& data, rapidjson::Value& chunk, rapidjson::MemoryPoolAllocator<>& allocator);
+
+	// Heightmap upkeep, positions are in world coordinates. Call after the scene has been changed
+	void blockPlaced(const Eigen::Vector2i& pos, const Components::Item type);
+	void blockBroken(class Scene* scene, const Eigen::Vector2i& pos);
+	// Tile at pos (world coordinates), air if it's outside of the grid
+	[[nodiscard]] Components::Item getTile(const Eigen::Vector2i& pos) const;
+	[[nodiscard]] const Grid& getTiles() const { return mTiles; }
+	// Entity last spawned at pos, MAX_ENTITIES if unknown. It can be stale, check the block before using it
+	[[nodiscard]] EntityID getEntity(const Eigen::Vector2i& pos) const;
+	void setEntity(const Eigen::Vector2i& pos, const EntityID entity);
+	// Top solid block of the column x (world coordinates), NO_SURFACE if there is none
+	[[nodiscard]] std::int64_t getSurface(const std::int64_t x) const {
+		return mHeightMap[x - mPosition * CHUNK_WIDTH];
+	}
+	// Structure blocks that were spawned in the neighbouring chunks
+	[[nodiscard]] std::vector<std::pair<Components::Item, Eigen::Vector2i>> takeOverflow() {
+		return std::move(mOverflow);
+	}
+
+	// Blocks that stop the player and hide the sky
+	[[nodiscard]] static bool isSolid(const Components::Item type);
+	// Adds the entity of a block to the scene, doesn't update any chunk
+	static EntityID spawnBlock(class Scene* scene, const Components::Item type, const Eigen::Vector2i& position);
 
 	[[nodiscard]] std::int64_t getPosition() const { return mPosition; }
+	// The chunk a block column is in
+	[[nodiscard]] constexpr static std::int64_t getChunk(const std::int64_t x) {
+		return (x < 0) ? (x + 1) / CHUNK_WIDTH - 1 : x / CHUNK_WIDTH;
+	}
 
       private:
+	// Off until blocks/water.png and blocks/lava.png exist, without them the lakes are drawn with the missing texture
+	constexpr const static inline bool LAKES = false;
 	constexpr const static inline char* const POSITION_KEY = "position";
 	constexpr const static inline char* const BLOCKS_KEY = "blocks";
 	constexpr const static inline char* const ITEMS_KEY = "items";
+	constexpr const static inline char* const HEIGHTMAP_KEY = "heightmap";
 
-	void spawnStructure(std::vector<std::vector<Components::Item>>& blocks, const Eigen::Vector2i& pos,
-			    const std::vector<std::pair<Components::Item, Eigen::Vector2i>> structure,
-			    class Scene* scene);
-	void carve(std::vector<std::vector<Components::Item>>& blocks, class NoiseGenerator* const noise);
-	void spawnOres(std::vector<std::vector<Components::Item>>& blocks, class NoiseGenerator* const noise);
+	static void spawnStructure(Tiles& tiles, const Eigen::Vector2i& pos, const std::int64_t position,
+				   const std::vector<std::pair<Components::Item, Eigen::Vector2i>>& structure);
+	static void carve(std::vector<std::vector<Components::Item>>& blocks, class NoiseGenerator* const noise);
+	static void spawnOres(std::vector<std::vector<Components::Item>>& blocks, class NoiseGenerator* const noise);
+	void setTile(const Eigen::Vector2i& pos, const Components::Item type);
 
 	const std::int64_t mPosition;
-	std::array<std::uint64_t, CHUNK_WIDTH> mHeightMap;
+	std::array<std::int64_t, CHUNK_WIDTH> mHeightMap;
+	Grid mTiles;
+	// Same layout as the tiles, so a block can be found without walking the scene
+	std::array<EntityID, CHUNK_WIDTH * MAX_HEIGHT> mEntities;
+	std::vector<std::pair<Components::Item, Eigen::Vector2i>> mOverflow;
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "scenes/chunk.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// LRU of recently unloaded chunks in their packed form, so walking back over a chunk border skips the json
+class ChunkCache {
+      public:
+	inline constexpr const static std::size_t MAX_SIZE = 1024 * 1024;
+
+	explicit ChunkCache(const std::size_t maxSize = MAX_SIZE);
+	ChunkCache(ChunkCache&&) = delete;
+	ChunkCache(const ChunkCache&) = delete;
+	ChunkCache& operator=(ChunkCache&&) = delete;
+	ChunkCache& operator=(const ChunkCache&) = delete;
+	~ChunkCache() = default;
+
+	// Returns the chunks evicted to make room, they have to be written back by the caller
+	[[nodiscard]] std::vector<Chunk::Packed> put(Chunk::Packed&& chunk);
+	// Moves the chunk out of the cache, false if it isn't cached
+	bool take(const std::int64_t position, Chunk::Packed& chunk);
+	// Empties the cache, returning everything in it
+	[[nodiscard]] std::vector<Chunk::Packed> flush();
+	void clear();
+
+	[[nodiscard]] std::size_t getSize() const { return mSize; }
+
+      private:
+	// Most recent first
+	std::list<Chunk::Packed> mEntries;
+	std::unordered_map<std::int64_t, std::list<Chunk::Packed>::iterator> mLookup;
+
+	std::size_t mSize;
+	const std::size_t mMaxSize;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "components.hpp"
+#include "scenes/chunk.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/rapidjson/document.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Water and lava as a cellular automaton over the tiles of the loaded chunks
+// Only the cells next to a change get looked at, when nothing changes anymore the fluid sleeps. The simulation keeps
+// its own copy of the tiles, the changes it makes are handed back to the level to apply
+class FluidSimulation {
+      public:
+	// Level of a source or falling fluid
+	inline constexpr const static std::uint8_t MAX_LEVEL = 8;
+
+	explicit FluidSimulation();
+	FluidSimulation(FluidSimulation&&) = delete;
+	FluidSimulation(const FluidSimulation&) = delete;
+	FluidSimulation& operator=(FluidSimulation&&) = delete;
+	FluidSimulation& operator=(const FluidSimulation&) = delete;
+	~FluidSimulation() = default;
+
+	// Fluid in the tiles is a source unless the chunk had been loaded before. Flow resumes across the borders
+	void addChunk(const std::int64_t position, const Chunk::Grid& tiles);
+	// Remembers the flowing cells and the pending updates of the chunk
+	void removeChunk(const std::int64_t position);
+	void clear();
+
+	void load(const rapidjson::Value& data);
+	void save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& allocator) const;
+
+	// A block got placed or broken, wakes the fluid around
+	void setTile(const Eigen::Vector2i& pos, const Components::Item type);
+	// Steps the fluids due on this game tick, the changed tiles are in getChanges() until the next call
+	void tick(const std::uint64_t tick);
+
+	[[nodiscard]] const std::vector<std::pair<Eigen::Vector2i, Components::Item>>& getChanges() const {
+		return mChanges;
+	}
+	// Cells waiting for an update, 0 once everything settled
+	[[nodiscard]] std::size_t getActive() const { return mActive[0].size() + mActive[1].size(); }
+	// Fluid level of a cell, 0 if there is no fluid
+	[[nodiscard]] std::uint8_t getLevel(const Eigen::Vector2i& pos) const;
+
+	[[nodiscard]] static bool isFluid(const Components::Item type);
+
+      private:
+	inline constexpr const static int SIZE = Chunk::CHUNK_WIDTH * Chunk::MAX_HEIGHT;
+	inline constexpr const static char* const POSITION_KEY = "position";
+	inline constexpr const static char* const FLOWING_KEY = "flowing";
+	inline constexpr const static char* const ACTIVE_KEY = "active";
+
+	// Cell byte: what's in it in bits 4 and 5, fluid level in the lower 4 bits
+	inline constexpr const static std::uint8_t EMPTY = 0x00;
+	inline constexpr const static std::uint8_t SOLID = 0x30;
+	inline constexpr const static std::uint8_t KIND = 0x30;
+	inline constexpr const static std::uint8_t SOURCE = 0x40;
+	inline constexpr const static std::uint8_t LEVEL = 0x0F;
+
+	struct Fluid {
+		Components::Item mItem;
+		std::uint8_t mKind;
+		// Game ticks between two steps
+		std::uint64_t mDelay;
+		// Level lost per cell flowing sideways
+		std::uint8_t mDecay;
+	};
+
+	static const std::array<Fluid, 2> FLUIDS;
+
+	struct Section {
+		std::array<std::uint8_t, SIZE> mCells;
+		// Bit n set if the cell is in mActive[n]
+		std::array<std::uint8_t, SIZE> mQueued;
+	};
+
+	struct Parked {
+		// Cell index and cell of everything that isn't a source
+		std::vector<std::pair<std::uint16_t, std::uint8_t>> mFlowing;
+		std::array<std::vector<std::uint16_t>, 2> mActive;
+	};
+
+	[[nodiscard]] static std::uint8_t getCell(const Components::Item type);
+	[[nodiscard]] static Components::Item getItem(const std::uint8_t cell);
+
+	// nullptr if the cell isn't loaded
+	Section* getSection(const Eigen::Vector2i& pos, int& index) const;
+	// Unloaded cells are solid
+	[[nodiscard]] std::uint8_t getCell(const Eigen::Vector2i& pos) const;
+
+	void queue(const Eigen::Vector2i& pos, const std::size_t fluid);
+	// Queue the cells that look at pos
+	void wake(const Eigen::Vector2i& pos);
+	void step(const std::size_t fluid);
+	// The cell pos should have with the current state of its neighbours
+	[[nodiscard]] std::uint8_t update(const Eigen::Vector2i& pos, const std::size_t fluid) const;
+
+	std::unordered_map<std::int64_t, Section> mSections;
+	// Most lookups are in the same chunk as the last
+	mutable Section* mLastSection;
+	mutable std::int64_t mLastPosition;
+	std::unordered_map<std::int64_t, Parked> mParked;
+
+	std::array<std::vector<Eigen::Vector2i>, 2> mActive;
+	// Kept around so steps don't allocate
+	std::vector<Eigen::Vector2i> mProcessing;
+	std::vector<std::pair<Eigen::Vector2i, std::uint8_t>> mPending;
+	std::vector<std::pair<Eigen::Vector2i, Components::Item>> mChanges;
+};
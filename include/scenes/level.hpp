@@ -1,6 +1,7 @@
 #pragma once
 
 #include "managers/entityManager.hpp"
+#include "scenes/chunk.hpp"
 #include "third_party/rapidjson/document.h"
 
 #include <cstdint>
@@ -18,6 +19,8 @@ class Level {
 	~Level();
 
 	void create();
+	// Same as create but with the given seed, the world comes out the same every time
+	void create(const std::uint64_t seed);
 	void load(rapidjson::Value& data);
 	void save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& allocator);
 
@@ -28,16 +31,54 @@ class Level {
 	void update(float delta);
 	std::int64_t getPosition();
 
+	// Heightmap queries, O(1) but only for the loaded chunks, NO_SURFACE otherwise
+	[[nodiscard]] std::int64_t surfaceAt(const std::int64_t x) const;
+	[[nodiscard]] bool isSkyVisible(const std::int64_t x, const std::int64_t y) const;
+	// Keep the heightmaps up to date, call after changing the blocks of the scene
+	// Passing the entity of the placed block saves looking for it when it changes again
+	void blockPlaced(const Eigen::Vector2i& pos, const Components::Item type, const EntityID entity = MAX_ENTITIES);
+	void blockBroken(const Eigen::Vector2i& pos);
+	// Light level from 0 to 15 of a cell
+	[[nodiscard]] std::uint8_t getLight(const Eigen::Vector2i& pos) const;
+	// Tile at pos, air if its chunk isn't loaded
+	[[nodiscard]] Components::Item getTile(const Eigen::Vector2i& pos) const;
+	// Grid of a loaded chunk, nullptr if it isn't loaded
+	[[nodiscard]] const Chunk::Grid* getTiles(const std::int64_t position) const;
+	// Replace the block at pos in a loaded chunk, for blocks changing on their own
+	void setBlock(const Eigen::Vector2i& pos, const Components::Item type);
+	[[nodiscard]] class BlockTicker* getTicker() const { return mTicker.get(); }
+
       private:
 	inline constexpr const static char* const CHUNK_KEY = "chunks";
 	inline constexpr const static char* const PLAYER_KEY = "player";
+	inline constexpr const static char* const TICKS_KEY = "ticks";
+	inline constexpr const static char* const FLUIDS_KEY = "fluids";
 	inline constexpr const static uint64_t ROLL_TIME = 5000;
 
 	void createCommon();
+	// Entity of the block at pos in a loaded chunk, MAX_ENTITIES if there's none
+	[[nodiscard]] EntityID findBlock(const Eigen::Vector2i& pos);
+
+	// The json of a chunk, padding the chunk arrays if needed
+	rapidjson::Value& getChunkData(const std::int64_t position);
+	// The loaded chunk at position, nullptr if it isn't loaded
+	class Chunk* getChunk(const std::int64_t position) const;
+	// Loads from the cache, then the save, or generates a new chunk
+	class Chunk* loadChunk(const std::int64_t position);
+	// Packs the chunk into the cache and deletes it
+	void unloadChunk(class Chunk* chunk);
+	// Writes a chunk evicted from the cache back to the json
+	void writeBack(const Chunk::Packed& chunk);
+	// Keeps the heightmaps, light and ticks in sync with a changed tile
+	void changeTile(const Eigen::Vector2i& pos, const Components::Item type);
+	// Puts the changes of the last fluid step in the scene
+	void applyFluids();
 
 	const std::string mName;
 	EntityID mTextID;
 	uint64_t mLastTime;
+	// Time not yet spent on game ticks
+	float mTickTime;
 
 	rapidjson::Document mData;
 
@@ -50,4 +91,8 @@ class Level {
 	class Scene* mScene;
 
 	std::unique_ptr<class NoiseGenerator> mNoise;
+	std::unique_ptr<class ChunkCache> mCache;
+	std::unique_ptr<class LightEngine> mLight;
+	std::unique_ptr<class BlockTicker> mTicker;
+	std::unique_ptr<class FluidSimulation> mFluids;
 };
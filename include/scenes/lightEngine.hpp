@@ -0,0 +1,87 @@
+#pragma once
+
+#include "components.hpp"
+#include "scenes/chunk.hpp"
+#include "third_party/Eigen/Core"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Sky and block light of the loaded chunks
+// Both get flood filled from their sources. When a block changes, the light that went through it is removed and
+// then refilled from the cells around, so an update only touches the cells it lights
+class LightEngine {
+      public:
+	inline constexpr const static std::uint8_t MAX_LIGHT = 15;
+
+	explicit LightEngine();
+	LightEngine(LightEngine&&) = delete;
+	LightEngine(const LightEngine&) = delete;
+	LightEngine& operator=(LightEngine&&) = delete;
+	LightEngine& operator=(const LightEngine&) = delete;
+	~LightEngine() = default;
+
+	// Lights a new chunk, light flows in and out of the loaded neighbours
+	void addChunk(const std::int64_t position, const Chunk::Grid& tiles);
+	// The light that came from the chunk stays in the neighbours until they change
+	void removeChunk(const std::int64_t position);
+	void clear();
+
+	// A block got placed or broken
+	void setTile(const Eigen::Vector2i& pos, const Components::Item type);
+
+	// Max of the sky and block light, 0 in unloaded chunks
+	[[nodiscard]] std::uint8_t getLight(const Eigen::Vector2i& pos) const;
+	[[nodiscard]] std::uint8_t getSkyLight(const Eigen::Vector2i& pos) const;
+	[[nodiscard]] std::uint8_t getBlockLight(const Eigen::Vector2i& pos) const;
+
+      private:
+	inline constexpr const static int SIZE = Chunk::CHUNK_WIDTH * Chunk::MAX_HEIGHT;
+	// Flag in the tile byte, the lower 4 bits are the emitted light
+	inline constexpr const static std::uint8_t OPAQUE = 0x10;
+	// Light lost going into a cell
+	inline constexpr const static std::uint8_t TRANSPARENT_COST = 1;
+	inline constexpr const static std::uint8_t OPAQUE_COST = 4;
+
+	enum class Channel { SKY, BLOCK };
+
+	struct Section {
+		// Sky light in the upper 4 bits, block light in the lower 4 bits
+		std::array<std::uint8_t, SIZE> mLight;
+		std::array<std::uint8_t, SIZE> mTiles;
+	};
+
+	struct Removal {
+		Eigen::Vector2i mPos;
+		std::uint8_t mLevel;
+	};
+
+	[[nodiscard]] static std::uint8_t getTileFlags(const Components::Item type);
+	[[nodiscard]] static std::uint8_t getChannel(const std::uint8_t light, const Channel channel) {
+		return channel == Channel::SKY ? light >> 4 : light & 0x0F;
+	}
+	static void setChannel(std::uint8_t& light, const Channel channel, const std::uint8_t level) {
+		light = channel == Channel::SKY ? (light & 0x0F) | (level << 4) : (light & 0xF0) | level;
+	}
+
+	// nullptr if the cell isn't loaded
+	Section* getSection(const Eigen::Vector2i& pos, int& index) const;
+
+	// Spreads the light of the cells in mQueue
+	void propagate(const Channel channel);
+	// Darkens the cells lit by the cells in mRemoveQueue, the cells bordering them end up in mQueue
+	void unpropagate(const Channel channel);
+	// Remove then refill around a changed cell
+	void relight(const Eigen::Vector2i& pos, const Channel channel);
+
+	std::unordered_map<std::int64_t, Section> mSections;
+	// Most lookups are in the same chunk as the last
+	mutable Section* mLastSection;
+	mutable std::int64_t mLastPosition;
+
+	// Kept around so updates don't allocate
+	std::vector<Eigen::Vector2i> mQueue;
+	std::vector<Removal> mRemoveQueue;
+};
@@ -22,17 +22,28 @@ class UISystem {
 	void draw(class Scene* scene);
 
 	void addScreen(class Screen* screen) { mScreenStack.emplace_back(screen); }
+	// For the ticks, which run next to the frame being drawn, the screen gets added on the main thread by
+	// openRequested at the start of the next frame
+	void requestScreen(class Screen* screen) { mRequested = screen; }
+	void openRequested() {
+		if (mRequested != nullptr) {
+			addScreen(mRequested);
+			mRequested = nullptr;
+		}
+	}
 	void pop() {
 		SDL_assert(!mScreenStack.empty());
 		mScreenStack.pop_back();
 	}
 	[[nodiscard]] class Screen* top() { return mScreenStack.back(); }
 
-	bool empty() const { return mScreenStack.empty(); }
+	// A requested screen counts, the ticks stay paused until it's open
+	bool empty() const { return mScreenStack.empty() && mRequested == nullptr; }
 	[[nodiscard]] class Mesh* getMesh() const { return mMesh.get(); }
 
       private:
 	class Game* mGame;
 	std::unique_ptr<class Mesh> mMesh;
 	std::vector<class Screen*> mScreenStack;
+	class Screen* mRequested;
 };
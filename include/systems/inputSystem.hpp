@@ -14,7 +14,9 @@ class InputSystem {
 	InputSystem& operator=(const InputSystem&) = delete;
 	~InputSystem() = default;
 
-	// Updates velocity and mouse
+	// Runs the input functions of the entities, once per simulation tick
+	void tick(class Scene* scene, const float delta);
+	// Updates the mouse, once per frame
 	void update(class Scene* scene, const float delta);
 	void draw(class Scene* scene);
 
@@ -1,10 +1,18 @@
 #pragma once
 
+#include "components.hpp"
 #include "managers/entityManager.hpp"
+#include "misc/integration.hpp"
+#include "misc/parallel.hpp"
 #include "opengl/shader.hpp"
+#include "scenes/chunk.hpp"
+#include "third_party/Eigen/Core"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 class PhysicsSystem {
       public:
@@ -19,23 +27,95 @@ class PhysicsSystem {
 
 	void update(class Scene* scene, const float delta);
 	void collide(class Scene* scene);
+	// The collision box editor of the developer menu, on the main thread since the ticks run next to the frame
+	void editor(class Scene* scene);
+
+	// Chunk in the middle of the loaded ones, the tile grid covers it and its two neighbours
+	void setCenter(const std::int64_t chunk) { mCenter = chunk; }
+
+	// A block got placed or broken, its tile gets looked at again on the next update
+	void tileChanged(const Eigen::Vector2i& pos);
+	// A chunk got loaded or unloaded
+	void chunkChanged(const std::int64_t position);
+	// Has to be called before writing the velocity of an entity that might be asleep, sleepers have no velocity
+	// The input system wakes the entities it hands to their input functions, anything else moving entities has to
+	// call it itself
+	void wake(class Scene* scene, const EntityID entity);
 
       private:
 	constexpr const static inline std::uint64_t PICK_UP_RANGE = 150;
 	constexpr const static inline std::uint64_t PICK_UP_RANGE_SQ = PICK_UP_RANGE * PICK_UP_RANGE;
+	constexpr const static inline std::uint64_t MERGE_RANGE = Components::block::BLOCK_SIZE / 2;
+	constexpr const static inline std::uint64_t MERGE_RANGE_SQ = MERGE_RANGE * MERGE_RANGE;
+	// Anything in range of a position is in its cell or the ones around
+	constexpr const static inline float ITEM_CELL_SIZE = PICK_UP_RANGE;
+	// Entities per thread when resolving the collisions, less isn't worth waking a thread
+	constexpr const static inline std::size_t COLLIDE_GRAIN = 512;
+	// Ticks standing still on the ground before falling asleep
+	constexpr const static inline std::uint64_t REST_TICKS = 30;
+	// The three loaded chunks
+	constexpr const static inline std::int64_t GRID_WIDTH = Chunk::CHUNK_WIDTH * 3;
+	constexpr const static inline EntityID NO_BLOCK = MAX_ENTITIES;
+	// Tile waiting for its block while updating the grid
+	constexpr const static inline EntityID DIRTY_BLOCK = MAX_ENTITIES - 1;
 
 	// Collision tests
-	bool AABBxAABB(const class Scene* scene, const EntityID entity, const EntityID block) const;
+	bool AABBxAABB(const class Scene* scene, const Eigen::Vector2f& min, const Eigen::Vector2f& size,
+		       const EntityID block) const;
 	bool collidingBellow(const class Scene* scene, const EntityID entity, const EntityID block) const;
-	void pushBack(class Scene* scene, const EntityID entity, EntityID block);
-	// Manages the falling and picking of items
+	// Standing on a block, remembers the block to check it first next time
+	bool onGround(class Scene* scene, const EntityID entity);
+	// Moves min out of the block, only reads the scene so it's safe to call from any thread
+	void pushBack(const class Scene* scene, Eigen::Vector2f& min, const Eigen::Vector2f& size,
+		      const EntityID block) const;
+	// Manages the merging and picking of items
 	void itemPhysics(class Scene* scene);
+	// Wakes the sleeping entities that stood on or next to a changed tile
+	void wakeAround(class Scene* scene);
+	[[nodiscard]] static std::uint64_t itemCell(const Eigen::Vector2f& position, const int dx = 0, const int dy = 0);
+
+	// Follows the loaded chunks and applies the changed tiles, PHYSICS_DIRTY_SIGNAL rebuilds everything
+	void updateGrid(class Scene* scene);
+	void buildGrid(class Scene* scene);
+	// The blocks in the tiles overlapping the box, in world coordinates
+	void queryTiles(const Eigen::Vector2f& min, const Eigen::Vector2f& max, std::vector<EntityID>& blocks) const;
 
-	class Game* mGame;
+	std::int64_t mCenter;
 
 	// Collision cache
 	struct {
 		std::unordered_map<EntityID, EntityID> lastAbove;
-		std::array<std::array<EntityID, 16 * 3>, 128> chunk;
 	} mCache;
+
+	// Collision blocks of the loaded chunks, indexed by (x - mLeft) * MAX_HEIGHT + y
+	struct {
+		std::int64_t mLeft;
+		std::array<EntityID, GRID_WIDTH * Chunk::MAX_HEIGHT> mTiles;
+		// Blocks that don't fit in the grid, always part of the results
+		std::vector<EntityID> mOutside;
+	} mGrid;
+	// Changes since the last update, applied with a single pass over the blocks
+	struct {
+		std::vector<Eigen::Vector2i> mTiles;
+		std::vector<std::int64_t> mChunks;
+	} mDirty;
+	// Reused between the queries
+	std::vector<EntityID> mQuery;
+	// The moving entities of this tick and their velocities
+	std::vector<EntityID> mBodies;
+	integration::Columns mColumns;
+	// Collision boxes of the moving entities, resolved in parallel
+	struct Box {
+		EntityID mEntity;
+		Eigen::Vector2f mMin;
+		Eigen::Vector2f mSize;
+	};
+	std::vector<Box> mBoxes;
+	parallel::Pool mPool;
+	// Ticks every entity has been resting for
+	std::unordered_map<EntityID, std::uint64_t> mResting;
+	// Entities changing state once we are done walking the views
+	std::vector<EntityID> mToggled;
+	// Spatial hash of the items, rebuilt every tick
+	std::unordered_map<std::uint64_t, std::vector<EntityID>> mItemCells;
 };
@@ -1,12 +1,25 @@
 #pragma once
 
+#include "opengl/chunkMesh.hpp"
+#include "opengl/glState.hpp"
+#include "opengl/profiler.hpp"
+#include "third_party/Eigen/Core"
+
 #include <SDL3/SDL_video.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // TODO: DPI
 class RenderSystem {
       public:
+	using Pass = Profiler::Pass;
+
 	explicit RenderSystem() noexcept;
 	RenderSystem(RenderSystem&&) = delete;
 	RenderSystem(const RenderSystem&) = delete;
@@ -20,19 +33,80 @@ class RenderSystem {
 	[[nodiscard]] class Texture* getTexture(const std::string& name, const bool srgb = false);
 	[[nodiscard]] class Shader* getShader(const std::string& vert, const std::string& frag,
 					      const std::string& geom = "");
+	// The HUD and the text go through here, flushed once everything's submitted
+	[[nodiscard]] class RenderQueue* getRenderQueue() const { return mQueue.get(); }
+	// Draw calls and state changes of the last frame
+	[[nodiscard]] const GLState::Stats& getFrameStats() const { return mFrameStats; }
+	// CPU and GPU time of every pass
+	[[nodiscard]] class Profiler* getProfiler() const { return mProfiler.get(); }
+	[[nodiscard]] class Framebuffer* getFramebuffer() const { return mFramebuffer.get(); }
+
+	// Time the draws after this as the pass, until the next one begins or endPass
+	void beginPass(const Pass pass);
+	void endPass();
 
 	void setDemensions(int width, int height);
 
-	void draw(class Scene* scene);
+	// Takes what the draw needs from the scene, the scene can change after, draw only uses what got recorded
+	void record(class Scene* scene);
+	void draw();
+	// Draws what got submitted to the render queue
+	void flush();
+	// The block meshes follow the chunks of the level, they get rebuilt on the next record
+	// These can come from the simulation while the last frame is drawn, so they don't touch GL
+	void chunkLoaded(const std::int64_t position);
+	void chunkUnloaded(const std::int64_t position);
+	// A block got placed or broken, the light changes too
+	void tileChanged(const Eigen::Vector2i& pos);
+	void clearChunks();
 	void reload() const;
 	void swapWindow() const;
-	void present() const;
+	void present();
 
       private:
+	// Size of the atlas uniform block, a texture for every item
+	constexpr const static inline std::size_t ATLAS_ITEMS = 64;
+
+	// Layout of the Frame uniform block
+	struct FrameUniforms {
+		Eigen::Vector2f mCamera;
+		float mTime;
+		float mPadding;
+	};
+	static_assert(sizeof(FrameUniforms) == 16, "std140 vec2 then float, padded to a vec4");
+
+	// What the draw takes from the scene
+	// The sprites wait in the sprite batch and the HUD and the text in the render queue
+	struct Snapshot {
+		Eigen::Vector2f mCamera;
+		float mTime;
+		// Blocks on screen, in blocks
+		float mLeft, mRight;
+		// Offset and size of the hitboxes of the debug overlay
+		std::vector<std::pair<Eigen::Vector2f, Eigen::Vector2f>> mHitboxes;
+	};
+
+	// Layers of the HUD, from the bottom
+	enum HUDLayer : int {
+		HOTBAR,
+		SELECTION,
+		ITEMS,
+		COUNTS,
+	};
+
 	void setLights(class Shader* shader) const;
 	void setOrtho() const;
 	void setPersp() const;
 	void drawHUD(class Scene* scene);
+	void markChunk(const std::int64_t position);
+	// Creates and deletes the meshes of the chunks loaded and unloaded since the last frame
+	void applyChunkChanges();
+	// Rebuilds the instances of the changed chunks and uploads what's different
+	void updateChunks(class Scene* scene);
+	// Uploads where the block textures are in the atlas if it changed
+	void updateAtlas();
+	void addSprite(const class Texture* const texture, const int layer, const Eigen::Vector2f& position,
+		       const Eigen::Vector2f& size, const Eigen::Vector4f& uv);
 
 	class Game* mGame;
 
@@ -44,10 +118,31 @@ class RenderSystem {
 	std::unique_ptr<class GLManager> mGL;
 	std::unique_ptr<class Framebuffer> mFramebuffer;
 	std::unique_ptr<class UBO> mMatricesUBO;
+	std::unique_ptr<class UBO> mAtlasUBO;
+	std::array<Eigen::Vector4f, ATLAS_ITEMS> mAtlasRects;
+	std::unique_ptr<class UBO> mFrameUBO;
+	// What the frame block has, to not upload it again when nothing moved
+	FrameUniforms mFrameUniforms;
 	std::unique_ptr<class TextureManager> mTextures;
 	std::unique_ptr<class ShaderManager> mShaders;
 
 	std::unique_ptr<class Mesh> mMesh;
+	std::unique_ptr<class SpriteBatch> mSprites;
+	std::unique_ptr<class RenderQueue> mQueue;
+	GLState::Stats mFrameStats;
+	std::unique_ptr<Profiler> mProfiler;
+
+	Snapshot mSnapshot;
+	// Show the hitboxes, from the developer menu
+	bool mHitboxes;
+
+	std::unordered_map<std::int64_t, std::unique_ptr<ChunkMesh>> mChunkMeshes;
+	// Chunks loaded (true) or unloaded since the last frame, in order
+	std::vector<std::pair<std::int64_t, bool>> mChunkChanges;
+	std::vector<std::int64_t> mDirtyChunks;
+	// Kept between the updates to not reallocate
+	std::vector<ChunkMesh::Instance> mChunkInstances;
+	std::vector<std::pair<std::int64_t, ChunkMesh::Instance>> mOutsideBlocks;
 
 	int mWidth, mHeight;
 };
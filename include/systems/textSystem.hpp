@@ -1,5 +1,6 @@
 #pragma once
 
+#include "opengl/renderQueue.hpp"
 #include "third_party/Eigen/Core"
 #include "third_party/stb_truetype.h"
 
@@ -20,8 +21,12 @@ class TextSystem {
 	void loadFont(const std::string& name);
 	// Size in 1/64 of a pixel
 	void draw(class Scene* scene);
+	// Draws right away, for the screens
 	void draw(std::string_view str, const Eigen::Vector2f& offset, bool translate,
 		  const Eigen::Vector3f& color = COLOR);
+	// Queues the glyphs, they're drawn when the queue gets flushed
+	void submit(class RenderQueue* queue, const RenderQueue::Pass pass, const int layer, std::string_view str,
+		    const Eigen::Vector2f& offset, bool translate, const Eigen::Vector3f& color = COLOR);
 
       private:
 	const static inline Eigen::Vector3f COLOR = Eigen::Vector3f(0.0f, 0.0f, 0.0f);
@@ -34,7 +39,9 @@ class TextSystem {
 		Eigen::Vector2f advance;
 	};
 
-	void drawGlyph(const char32_t character, class Shader* shader, const Eigen::Vector2f& offset);
+	void submitGlyph(class RenderQueue* queue, const RenderQueue::Pass pass, const int layer,
+			 const char32_t character, class Shader* shader, const Eigen::Vector2f& offset,
+			 const Eigen::Vector3f& color);
 	Glyph& getGlyph(const char32_t character);
 
 	class Game* mGame;
@@ -2,6 +2,7 @@
 
 #include "game.hpp"
 #include "managers/eventManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/systemManager.hpp"
 #include "opengl/mesh.hpp"
 #include "opengl/texture.hpp"
@@ -86,7 +87,7 @@ bool CraftingInventory::update(class Scene* const scene, const float delta) {
 	const float sizey = sloty * mRows;
 
 	float mouseX, mouseY;
-	SDL_GetMouseState(&mouseX, &mouseY);
+	ReplayManager::getMouseState(&mouseX, &mouseY);
 	mouseY = dimensions.y() - mouseY;
 
 	// Test if player is placing inside grid
@@ -135,7 +136,7 @@ bool CraftingInventory::update(class Scene* const scene, const float delta) {
 			}
 
 			lastClickPos = slot;
-			lastClick = SDL_GetTicks();
+			lastClick = ReplayManager::getTicks();
 			scene->getSignal(EventManager::LEFT_CLICK_DOWN_SIGNAL) = false;
 		} else if (scene->getSignal(EventManager::RIGHT_CLICK_DOWN_SIGNAL) && mPath.empty()) {
 			// Not empty hand on empty slot
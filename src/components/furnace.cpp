@@ -3,11 +3,13 @@
 #include "game.hpp"
 #include "items.hpp"
 #include "managers/eventManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/systemManager.hpp"
 #include "opengl/mesh.hpp"
 #include "opengl/texture.hpp"
 #include "registers.hpp"
 #include "scene.hpp"
+#include "scenes/blockTicker.hpp"
 #include "systems/UISystem.hpp"
 
 #include <SDL3/SDL.h>
@@ -18,7 +20,8 @@
 // Crafting table
 FurnaceInventory::FurnaceInventory(struct furnace_t)
 	: Inventory(Eigen::Vector2f(8, 8), "ui/furnace.png"), mSmeltingItems(3, Components::AIR()),
-	  mSmeltingCount(3, 0), mFuelTime(0), mFuelLeft(0), mRecipieTime(0), mLastRecipie(Components::AIR()) {
+	  mSmeltingCount(3, 0), mFuelTime(0), mFuelLeft(0), mRecipieTime(0), mLastRecipie(Components::AIR()),
+	  mLastTick(0) {
 	mCountRegister[getID<FurnaceInventory>()] = &mSmeltingCount;
 	mItemRegister[getID<FurnaceInventory>()] = &mSmeltingItems;
 }
@@ -55,7 +58,7 @@ bool FurnaceInventory::update(class Scene* const scene, const float delta) {
 	const float sloty = INVENTORY_SLOT_Y * scale;
 
 	float mouseX, mouseY;
-	SDL_GetMouseState(&mouseX, &mouseY);
+	ReplayManager::getMouseState(&mouseX, &mouseY);
 	mouseY = dimensions.y() - mouseY;
 
 	// Test if player is placing inside grid
@@ -121,7 +124,7 @@ bool FurnaceInventory::update(class Scene* const scene, const float delta) {
 			}
 
 			lastClickPos = slot;
-			lastClick = SDL_GetTicks();
+			lastClick = ReplayManager::getTicks();
 			scene->getSignal(EventManager::LEFT_CLICK_DOWN_SIGNAL) = false;
 		} else if (scene->getSignal(EventManager::RIGHT_CLICK_DOWN_SIGNAL) && mPath.empty()) {
 			// Not empty hand on empty slot
@@ -204,7 +207,50 @@ bool FurnaceInventory::update(class Scene* const scene, const float delta) {
 	return Inventory::update(scene, delta);
 }
 
-void FurnaceInventory::tick(class Scene* const, float delta) {
+void FurnaceInventory::tick(class Scene* const, const std::uint64_t tick) {
+	// Every furnace block ticks this, the first one each tick moves it forward
+	if (mLastTick == 0 || tick < mLastTick) {
+		mLastTick = tick;
+
+		return;
+	}
+
+	if (tick == mLastTick) {
+		return;
+	}
+
+	// Usually a single tick. After the furnaces were unloaded it's the time they were away, smelted a recipe or a
+	// fuel item at a time so it burns the fuel it would have
+	double left = (tick - mLastTick) * BlockTicker::TICK_LENGTH;
+	mLastTick = tick;
+	for (std::uint64_t steps = 0; left > 0 && steps < MAX_CATCH_UP; ++steps) {
+		double step = left;
+		if (registers::SMELTING_RECIPIE.contains(mSmeltingItems[COOK_SLOT])) {
+			step = std::min(step, registers::SMELTING_RECIPIE.at(mSmeltingItems[COOK_SLOT]).first - mRecipieTime);
+		}
+
+		if (mFuelLeft > 0) {
+			step = std::min(step, mFuelLeft);
+		}
+
+		// Never less than a tick, the recipe might have changed
+		step = std::clamp(step, std::min<double>(BlockTicker::TICK_LENGTH, left), left);
+		left -= step;
+
+		if (!smelt(step)) {
+			break;
+		}
+	}
+}
+
+void FurnaceInventory::placed(const std::uint64_t tick) {
+	// No furnace ticked last tick, the time before doesn't count
+	if (mLastTick + 1 < tick) {
+		mLastTick = 0;
+	}
+}
+
+bool FurnaceInventory::smelt(const double delta) {
 	if (registers::SMELTING_RECIPIE.contains(mSmeltingItems[COOK_SLOT])) {
 		const std::pair<double, Components::Item>& recipie =
 			registers::SMELTING_RECIPIE.at(mSmeltingItems[COOK_SLOT]);
@@ -220,7 +266,7 @@ void FurnaceInventory::tick(class Scene* const, float delta) {
 			mFuelLeft = 0;
 			mRecipieTime = 0;
 
-			return;
+			return false;
 		}
 
 		// Here the recipie is valid
@@ -249,7 +295,7 @@ void FurnaceInventory::tick(class Scene* const, float delta) {
 processFuel:
 	mFuelLeft -= delta;
 
-	if (mFuelLeft < 0) {
+	if (mFuelLeft <= 0) {
 		// Oh no! No more fuel, get some more or abort
 		if (mSmeltingCount[FUEL_SLOT] >= 1 && registers::BURNING_TIME.contains(mSmeltingItems[FUEL_SLOT]) &&
 		    registers::SMELTING_RECIPIE.contains(mSmeltingItems[COOK_SLOT]) &&
@@ -270,9 +316,11 @@ processFuel:
 
 			registers::TEXTURES[Components::Item::FURNACE] = "blocks/furnace.png";
 
-			return;
+			return false;
 		}
 	}
+
+	return true;
 }
 
 void FurnaceInventory::draw(class Scene* scene) {
@@ -4,6 +4,7 @@
 #include "items.hpp"
 #include "managers/entityManager.hpp"
 #include "managers/eventManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/systemManager.hpp"
 #include "opengl/mesh.hpp"
 #include "opengl/shader.hpp"
@@ -109,7 +110,7 @@ bool Inventory::update(class Scene* scene, float) {
 	oy += INVENTORY_SLOTS_OFFSET_Y * scale - (INVENTORY_SLOT_Y * scale / 2 - sy / INVENTORY_INV_SCALE);
 
 	float mouseX, mouseY;
-	SDL_GetMouseState(&mouseX, &mouseY);
+	ReplayManager::getMouseState(&mouseX, &mouseY);
 	mouseY = dimensions.y() - mouseY;
 
 	mouseX -= ox;
@@ -216,7 +217,7 @@ bool Inventory::update(class Scene* scene, float) {
 		}
 
 		mLastClickPos = slot;
-		mLastClick = SDL_GetTicks();
+		mLastClick = ReplayManager::getTicks();
 		scene->getSignal(EventManager::LEFT_CLICK_DOWN_SIGNAL) = false;
 	} else if (scene->getSignal(EventManager::RIGHT_CLICK_DOWN_SIGNAL) && mPath.empty()) {
 		if (mouseX < 0 || mouseY < 0 || mouseX > (9 * INVENTORY_SLOT_X * scale) ||
@@ -443,7 +444,7 @@ void Inventory::drawMouse(Scene* scene) {
 	const Eigen::Vector2f dimensions = systemManager->getDemensions();
 
 	float mx, my;
-	SDL_GetMouseState(&mx, &my);
+	ReplayManager::getMouseState(&mx, &my);
 	my = dimensions.y() - my;
 
 	shader->set("texture_diffuse"_u, 0);
@@ -494,5 +495,5 @@ void Inventory::pickUp(Scene* scene, const EntityID item, const std::size_t inde
 	SDL_assert((mCount[index] == 0 || mItems[index] == scene->get<Components::item>(item).mType));
 
 	mItems[index] = scene->get<Components::item>(item).mType;
-	mCount[index]++;
+	mCount[index] += scene->get<Components::item>(item).mCount;
 }
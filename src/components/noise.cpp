@@ -32,3 +32,8 @@ float NoiseGenerator::randf() {
 	static std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
 	return distribution(mRng);
 }
+
+void NoiseGenerator::seedChunk(const std::int64_t position) {
+	// Spread the chunks over the seed space, so neighbours don't get close seeds
+	mRng.seed(mSeed ^ (static_cast<std::uint64_t>(position) * 0x9E3779B97F4A7C15));
+}
@@ -6,6 +6,7 @@
 #include "opengl/texture.hpp"
 #include "registers.hpp"
 #include "scene.hpp"
+#include "scenes/level.hpp"
 #include "third_party/Eigen/Core"
 #include "third_party/rapidjson/fwd.h"
 
@@ -32,6 +33,9 @@ void PlayerInventory::tryPlace(class Scene* scene, const Eigen::Vector2i& pos) {
 		return;
 	}
 
+	// Whatever fluid was there is gone
+	mGame->getLevel()->setBlock(pos, Components::AIR());
+
 	Texture* texture = mGame->getSystemManager()->getTexture(registers::TEXTURES.at(mItems[mSelect]));
 	const EntityID entity = scene->newEntity();
 	scene->emplace<Components::block>(entity, mItems[mSelect], pos);
@@ -47,6 +51,8 @@ void PlayerInventory::tryPlace(class Scene* scene, const Eigen::Vector2i& pos) {
 		scene->emplace<Components::collision>(entity, Eigen::Vector2f(0.0f, 0.0f), texture->getSize(), true);
 	}
 
+	mGame->getLevel()->blockPlaced(pos, mItems[mSelect], entity);
+
 	--mCount[mSelect];
 	if (mCount[mSelect] == 0) {
 		mItems[mSelect] = Components::AIR();
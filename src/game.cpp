@@ -1,11 +1,12 @@
 #include "game.hpp"
 
-#include "components/furnace.hpp"
 #include "items.hpp"
 #include "managers/eventManager.hpp"
 #include "managers/localeManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/storageManager.hpp"
 #include "managers/systemManager.hpp"
+#include "misc/worker.hpp"
 #include "registers.hpp"
 #include "scene.hpp"
 #include "scenes/level.hpp"
@@ -20,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -59,28 +61,66 @@ void audioFailed(emscripten_fetch_t* fetch) {
 #endif
 
 Game::Game()
-	: mEventManager(nullptr), mSystemManager(nullptr), mLocaleManager(nullptr), mCurrentLevel(nullptr),
-	  mStorageManager(nullptr), mTicks(0), mStream(nullptr) {}
+	: mEventManager(nullptr), mReplayManager(nullptr), mSystemManager(nullptr), mLocaleManager(nullptr),
+	  mCurrentLevel(nullptr), mStorageManager(nullptr), mTicks(0), mAccumulator(0.0f), mSimulation(nullptr),
+	  mStream(nullptr) {}
 
-void Game::init() {
-	const auto begin = std::chrono::high_resolution_clock::now();
+void Game::createManagers() {
+	mSimulation = std::make_unique<Worker>();
 
 	// First initialize these subsystems because the other ones need it
 	mEventManager = std::make_unique<EventManager>();
+	mReplayManager = std::make_unique<ReplayManager>();
 
 	mSystemManager = std::make_unique<SystemManager>();
 	mLocaleManager = std::make_unique<LocaleManager>();
 
 	mCurrentLevel = std::make_unique<Level>();
 	mStorageManager = std::make_unique<StorageManager>();
+}
+
+void Game::init(const std::string& record, const std::string& replay) {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	createManagers();
+
+	// Recordings play on a fresh level, so the replay can start from the same one
+	if (!replay.empty()) {
+		if (!mReplayManager->replay(replay)) {
+			ERROR_BOX("Failed to read the replay");
+
+#ifdef __cpp_exceptions
+			throw std::runtime_error("Game.cpp: Failed to read replay " + replay);
+#endif
+		}
 
-	if (mStorageManager->restore() != 0) {
+		mSystemManager->setDemensions(mReplayManager->getWidth(), mReplayManager->getHeight());
+		// Replays run as fast as they can
+		SDL_GL_SetSwapInterval(0);
+
+		SDL_srand(mReplayManager->getSeed());
+		mCurrentLevel->create(mReplayManager->getSeed());
+	} else if (!record.empty()) {
+		const std::uint64_t seed = SDL_rand_bits() & 0x7FFFFFFF;
+		const auto dimensions = mSystemManager->getDemensions();
+		if (!mReplayManager->record(record, seed, static_cast<int>(dimensions.x()),
+					    static_cast<int>(dimensions.y()))) {
+			ERROR_BOX("Failed to open the recording");
+
+#ifdef __cpp_exceptions
+			throw std::runtime_error("Game.cpp: Failed to open recording " + record);
+#endif
+		}
+
+		SDL_srand(seed);
+		mCurrentLevel->create(seed);
+	} else if (mStorageManager->restore() != 0) {
 		SDL_Log("\033[31mFailed to read saved state, creating new state\033[0m");
 
 		mCurrentLevel->create();
 	}
 
-	mTicks = SDL_GetTicks();
+	mTicks = ReplayManager::getTicks();
 
 	const auto end = std::chrono::high_resolution_clock::now();
 	std::stringstream time;
@@ -149,6 +189,18 @@ void Game::init() {
 #endif
 }
 
+void Game::initHeadless(const std::uint64_t seed) {
+	createManagers();
+
+	// Nothing to wait for without a screen
+	SDL_GL_SetSwapInterval(0);
+
+	SDL_srand(seed);
+	mCurrentLevel->create(seed);
+
+	mTicks = ReplayManager::getTicks();
+}
+
 Game::~Game() {
 	SDL_Log("Quitting game\n");
 
@@ -165,7 +217,16 @@ Game::~Game() {
 	SDL_Quit();
 }
 
-void Game::save() { mStorageManager->save(); }
+void Game::save() {
+	// Recorded and replayed sessions play on a throwaway level
+	if (mReplayManager->recording() || mReplayManager->replaying()) {
+		mReplayManager->finish(mCurrentLevel->getScene(), mPlayer);
+
+		return;
+	}
+
+	mStorageManager->save();
+}
 
 SDL_AppResult Game::iterate() {
 	static std::size_t audioPtr = 0;
@@ -185,23 +246,49 @@ SDL_AppResult Game::iterate() {
 
 	const auto begin = std::chrono::high_resolution_clock::now();
 
-	float delta = static_cast<float>(SDL_GetTicks() - mTicks) / 1000.0f;
+	if (!mReplayManager->frame(mEventManager.get())) {
+		mReplayManager->finish(mCurrentLevel->getScene(), mPlayer);
+
+		return mReplayManager->matched() ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+	}
+
+	float delta = static_cast<float>(ReplayManager::getTicks() - mTicks) / 1000.0f;
 	if (delta > 0.1f) {
 		delta = 0.1f;
 
 		SDL_Log("\033[33mDelta > 0.1f, cutting frame short\033[0m");
 	}
-	mTicks = SDL_GetTicks();
+	mTicks = ReplayManager::getTicks();
 
 	mEventManager->update();
 
 	gui();
-	mCurrentLevel->update(delta);
 
-	// Tick the furnace
-	static_cast<class FurnaceInventory*>(registers::CLICKABLES.at(Components::Item::FURNACE)())
-		->tick(mCurrentLevel->getScene(), delta);
-	mSystemManager->update(mCurrentLevel->getScene(), delta);
+	// Draws the ticks of the last frame, the ticks of this one run on the simulation thread while it's submitted
+	Scene* const scene = mCurrentLevel->getScene();
+	mSystemManager->record(scene, delta, mAccumulator / SystemManager::TICK_LENGTH);
+
+	// The simulation runs at a fixed rate, whatever the frame rate is
+	mAccumulator += delta;
+	const auto simulate = [this, scene]() {
+		while (mAccumulator >= SystemManager::TICK_LENGTH) {
+			mAccumulator -= SystemManager::TICK_LENGTH;
+
+			mCurrentLevel->update(SystemManager::TICK_LENGTH);
+			mSystemManager->tick(scene, SystemManager::TICK_LENGTH);
+		}
+	};
+
+	// Screens read the scene while they're drawn
+	if (mSystemManager->drawsScreens()) {
+		simulate();
+	} else {
+		mSimulation->run(simulate);
+	}
+
+	mSystemManager->submit(scene);
+	mSimulation->wait();
+	mSystemManager->endFrame(scene);
 
 	const auto end = std::chrono::high_resolution_clock::now();
 	std::stringstream time;
@@ -209,6 +296,7 @@ SDL_AppResult Game::iterate() {
 	static std::uint64_t count = 0;
 	framerate += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
 	count++;
+	mReplayManager->frameTime(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
 
 	const auto uniqueEntity = [this]() {
 		const auto tid = this->mCurrentLevel->getScene()->newEntity();
@@ -308,5 +396,10 @@ SDL_AppResult Game::event(const SDL_Event& event) {
 		return SDL_APP_CONTINUE;
 	}
 
+	// The replay brings its own input
+	if (!mReplayManager->event(event)) {
+		return SDL_APP_CONTINUE;
+	}
+
 	return mEventManager->manageEvent(event);
 }
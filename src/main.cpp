@@ -15,11 +15,23 @@
 
 #include <exception>
 #include <stdexcept>
+#include <string>
 
 // The main class is in charge of sdl
-SDL_AppResult SDL_AppInit(void** appstate, int, char**) {
+SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv) {
 	SDL_srand(0);
 
+	// --record <file> saves the input of the session, --replay <file> plays it back
+	std::string record;
+	std::string replay;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (SDL_strcmp(argv[i], "--record") == 0) {
+			record = argv[++i];
+		} else if (SDL_strcmp(argv[i], "--replay") == 0) {
+			replay = argv[++i];
+		}
+	}
+
 	SDL_Log("Initializing cyao engine v1.0\n");
 
 	SDL_SetAppMetadata("Cyao", "1.0", "com.cyao.2d-minecraft");
@@ -49,7 +61,7 @@ SDL_AppResult SDL_AppInit(void** appstate, int, char**) {
 
 #ifdef __cpp_exceptions
 	try {
-		Game::getInstance()->init();
+		Game::getInstance()->init(record, replay);
 		*appstate = Game::getInstance();
 	} catch (const std::runtime_error& error) {
 		SDL_LogCritical(SDL_LOG_CATEGORY_VIDEO, "\033[31mMain.cpp: Critical runtime error: %s\033[0m\n",
@@ -67,7 +79,7 @@ SDL_AppResult SDL_AppInit(void** appstate, int, char**) {
 		return SDL_APP_FAILURE;
 	}
 #else
-	Game::getInstance()->init();
+	Game::getInstance()->init(record, replay);
 	*appstate = Game::getInstance();
 #endif
 
@@ -1,6 +1,7 @@
 #include "managers/eventManager.hpp"
 
 #include "game.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/systemManager.hpp"
 #include "scene.hpp"
 #include "scenes/level.hpp"
@@ -44,16 +45,16 @@ SDL_AppResult EventManager::manageEvent(const SDL_Event& event) {
 		// Mouse button down
 		case SDL_EVENT_MOUSE_BUTTON_DOWN: {
 			if (event.button.button == SDL_BUTTON_LEFT) {
-				mLeftClickDown = SDL_GetTicks();
+				mLeftClickDown = ReplayManager::getTicks();
 			} else if (event.button.button == SDL_BUTTON_RIGHT) {
-				mRightClickDown = SDL_GetTicks();
+				mRightClickDown = ReplayManager::getTicks();
 			}
 			break;
 		}
 
 		// Mouse button up
 		case SDL_EVENT_MOUSE_BUTTON_UP: {
-			std::uint64_t now = SDL_GetTicks();
+			std::uint64_t now = ReplayManager::getTicks();
 
 			if (event.button.button == SDL_BUTTON_LEFT) {
 				// If the time since press is less than threshold, treat as a click
@@ -85,8 +86,8 @@ SDL_AppResult EventManager::manageEvent(const SDL_Event& event) {
 }
 
 void EventManager::update() {
-	const auto buttons = SDL_GetMouseState(nullptr, nullptr);
-	const std::uint64_t now = SDL_GetTicks();
+	const auto buttons = ReplayManager::getMouseState(nullptr, nullptr);
+	const std::uint64_t now = ReplayManager::getTicks();
 
 	// Check left mouse hold
 	{
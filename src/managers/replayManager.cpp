@@ -0,0 +1,405 @@
+#include "managers/replayManager.hpp"
+
+#include "components.hpp"
+#include "components/inventory.hpp"
+#include "game.hpp"
+#include "managers/eventManager.hpp"
+#include "scene.hpp"
+#include "third_party/rapidjson/document.h"
+#include "third_party/rapidjson/stringbuffer.h"
+#include "third_party/rapidjson/writer.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+constexpr const std::uint64_t FNV_OFFSET = 0xcbf29ce484222325;
+constexpr const std::uint64_t FNV_PRIME = 0x100000001b3;
+
+std::uint64_t hashValues(const std::initializer_list<std::uint64_t> values) {
+	std::uint64_t hash = FNV_OFFSET;
+	for (const auto value : values) {
+		for (std::uint64_t i = 0; i < sizeof(value); ++i) {
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= FNV_PRIME;
+		}
+	}
+
+	return hash;
+}
+
+std::uint64_t floatBits(const float value) { return std::bit_cast<std::uint32_t>(value); }
+} // namespace
+
+ReplayManager::ReplayManager() noexcept
+	: mMode(Mode::NONE), mFile(nullptr), mSeed(0), mWidth(0), mHeight(0), mTicks(0), mMouseX(0.0f), mMouseY(0.0f),
+	  mButtons(0), mFrames(0), mExpected{0, 0, 0}, mMatched(false) {}
+
+ReplayManager::~ReplayManager() { close(); }
+
+bool ReplayManager::record(const std::string& path, const std::uint64_t seed, const int width, const int height) {
+	mFile = SDL_IOFromFile(path.data(), "wb");
+	if (mFile == nullptr) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "\033[31mFailed to open %s for recording: %s\033[0m",
+			     path.data(), SDL_GetError());
+
+		return false;
+	}
+
+	mMode = Mode::RECORD;
+	mPath = path;
+	mSeed = seed;
+	mWidth = width;
+	mHeight = height;
+	mTicks = SDL_GetTicks();
+	mButtons = SDL_GetMouseState(&mMouseX, &mMouseY);
+	mFrames = 0;
+
+	SDL_WriteU32LE(mFile, MAGIC);
+	SDL_WriteU32LE(mFile, VERSION);
+	SDL_WriteU64LE(mFile, mSeed);
+	SDL_WriteU32LE(mFile, static_cast<std::uint32_t>(mWidth));
+	SDL_WriteU32LE(mFile, static_cast<std::uint32_t>(mHeight));
+
+	SDL_Log("Recording to %s with seed %" PRIu64, mPath.data(), mSeed);
+
+	return true;
+}
+
+bool ReplayManager::replay(const std::string& path) {
+	mFile = SDL_IOFromFile(path.data(), "rb");
+	if (mFile == nullptr) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "\033[31mFailed to open replay %s: %s\033[0m", path.data(),
+			     SDL_GetError());
+
+		return false;
+	}
+
+	std::uint32_t magic = 0;
+	std::uint32_t version = 0;
+	std::uint32_t width = 0;
+	std::uint32_t height = 0;
+	if (!SDL_ReadU32LE(mFile, &magic) || !SDL_ReadU32LE(mFile, &version) || !SDL_ReadU64LE(mFile, &mSeed) ||
+	    !SDL_ReadU32LE(mFile, &width) || !SDL_ReadU32LE(mFile, &height) || magic != MAGIC || version != VERSION) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "\033[31m%s isn't a version %" PRIu32 " replay\033[0m",
+			     path.data(), VERSION);
+		close();
+
+		return false;
+	}
+
+	mMode = Mode::REPLAY;
+	mPath = path;
+	mWidth = static_cast<int>(width);
+	mHeight = static_cast<int>(height);
+	mTicks = 0;
+	mFrames = 0;
+	mTimes.clear();
+	mMatched = false;
+
+	SDL_Log("Replaying %s with seed %" PRIu64, mPath.data(), mSeed);
+
+	return true;
+}
+
+bool ReplayManager::event(const SDL_Event& event) {
+	if (mMode == Mode::NONE || mFile == nullptr) {
+		return true;
+	}
+
+	switch (event.type) {
+		case SDL_EVENT_KEY_DOWN:
+		case SDL_EVENT_KEY_UP: {
+			if (mMode == Mode::RECORD) {
+				SDL_WriteU8(mFile, event.type == SDL_EVENT_KEY_DOWN ? KEY_DOWN : KEY_UP);
+				SDL_WriteU16LE(mFile, static_cast<std::uint16_t>(event.key.scancode));
+			}
+
+			break;
+		}
+
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP: {
+			if (mMode == Mode::RECORD) {
+				SDL_WriteU8(mFile, event.type == SDL_EVENT_MOUSE_BUTTON_DOWN ? BUTTON_DOWN : BUTTON_UP);
+				SDL_WriteU8(mFile, event.button.button);
+			}
+
+			break;
+		}
+
+		case SDL_EVENT_WINDOW_RESIZED: {
+			if (mMode == Mode::RECORD) {
+				SDL_WriteU8(mFile, RESIZE);
+				SDL_WriteU32LE(mFile, static_cast<std::uint32_t>(event.window.data1));
+				SDL_WriteU32LE(mFile, static_cast<std::uint32_t>(event.window.data2));
+			}
+
+			break;
+		}
+
+		default:
+			return true;
+	}
+
+	return mMode == Mode::RECORD;
+}
+
+bool ReplayManager::frame(EventManager* events) {
+	if (mMode == Mode::NONE || mFile == nullptr) {
+		return true;
+	}
+
+	if (mMode == Mode::RECORD) {
+		// The clock of the recording moves by what got written, so it stays the same as the replay's
+		const std::uint64_t elapsed = std::min<std::uint64_t>(SDL_GetTicks() - mTicks, UINT16_MAX);
+		mTicks += elapsed;
+		mButtons = SDL_GetMouseState(&mMouseX, &mMouseY);
+		++mFrames;
+
+		SDL_WriteU8(mFile, FRAME);
+		SDL_WriteU16LE(mFile, static_cast<std::uint16_t>(elapsed));
+		SDL_WriteU32LE(mFile, std::bit_cast<std::uint32_t>(mMouseX));
+		SDL_WriteU32LE(mFile, std::bit_cast<std::uint32_t>(mMouseY));
+		SDL_WriteU8(mFile, static_cast<std::uint8_t>(mButtons));
+
+		return true;
+	}
+
+	std::uint8_t record = 0;
+	while (SDL_ReadU8(mFile, &record)) {
+		SDL_Event event{};
+
+		switch (record) {
+			case KEY_DOWN:
+			case KEY_UP: {
+				std::uint16_t scancode = 0;
+				SDL_ReadU16LE(mFile, &scancode);
+
+				event.type = record == KEY_DOWN ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+				event.key.scancode = static_cast<SDL_Scancode>(scancode);
+				event.key.key = SDL_GetKeyFromScancode(event.key.scancode, SDL_KMOD_NONE, false);
+				event.key.down = record == KEY_DOWN;
+
+				break;
+			}
+
+			case BUTTON_DOWN:
+			case BUTTON_UP: {
+				std::uint8_t button = 0;
+				SDL_ReadU8(mFile, &button);
+
+				event.type =
+					record == BUTTON_DOWN ? SDL_EVENT_MOUSE_BUTTON_DOWN : SDL_EVENT_MOUSE_BUTTON_UP;
+				event.button.button = button;
+				event.button.down = record == BUTTON_DOWN;
+
+				break;
+			}
+
+			case RESIZE: {
+				std::uint32_t width = 0;
+				std::uint32_t height = 0;
+				SDL_ReadU32LE(mFile, &width);
+				SDL_ReadU32LE(mFile, &height);
+
+				event.type = SDL_EVENT_WINDOW_RESIZED;
+				event.window.data1 = static_cast<Sint32>(width);
+				event.window.data2 = static_cast<Sint32>(height);
+
+				break;
+			}
+
+			case FRAME: {
+				std::uint16_t elapsed = 0;
+				std::uint32_t x = 0;
+				std::uint32_t y = 0;
+				std::uint8_t buttons = 0;
+				SDL_ReadU16LE(mFile, &elapsed);
+				SDL_ReadU32LE(mFile, &x);
+				SDL_ReadU32LE(mFile, &y);
+				SDL_ReadU8(mFile, &buttons);
+
+				mTicks += elapsed;
+				mMouseX = std::bit_cast<float>(x);
+				mMouseY = std::bit_cast<float>(y);
+				mButtons = buttons;
+				++mFrames;
+
+				return true;
+			}
+
+			case END: {
+				SDL_ReadU64LE(mFile, &mExpected.mFrames);
+				SDL_ReadU64LE(mFile, &mExpected.mWorld);
+				SDL_ReadU64LE(mFile, &mExpected.mPlayer);
+
+				return false;
+			}
+
+			default: {
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+					     "\033[31mUnknown record %" PRIu8 " in %s after frame %" PRIu64 "\033[0m",
+					     record, mPath.data(), mFrames);
+
+				return false;
+			}
+		}
+
+		(void)events->manageEvent(event);
+	}
+
+	SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "\033[31m%s ends without an end record, cut short?\033[0m",
+		     mPath.data());
+
+	return false;
+}
+
+void ReplayManager::frameTime(const std::uint64_t ns) {
+	if (mMode == Mode::REPLAY && mFile != nullptr) {
+		mTimes.emplace_back(ns);
+	}
+}
+
+void ReplayManager::finish(Scene* scene, const EntityID player) {
+	if (mMode == Mode::NONE || mFile == nullptr) {
+		return;
+	}
+
+	const std::uint64_t world = hashWorld(scene);
+	const std::uint64_t state = hashPlayer(scene, player);
+	const Eigen::Vector2f& position = scene->get<Components::position>(player).mPosition;
+	const Eigen::Vector2f& velocity = scene->get<Components::velocity>(player).mVelocity;
+
+	if (mMode == Mode::RECORD) {
+		SDL_WriteU8(mFile, END);
+		SDL_WriteU64LE(mFile, mFrames);
+		SDL_WriteU64LE(mFile, world);
+		SDL_WriteU64LE(mFile, state);
+
+		SDL_Log("Recorded %" PRIu64 " frames to %s, world %016" PRIx64 ", player %016" PRIx64
+			" at (%f, %f) moving (%f, %f)",
+			mFrames, mPath.data(), world, state, position.x(), position.y(), velocity.x(), velocity.y());
+	} else {
+		mMatched = mFrames == mExpected.mFrames && world == mExpected.mWorld && state == mExpected.mPlayer;
+
+		SDL_Log("%sReplayed %" PRIu64 "/%" PRIu64 " frames of %s, world %016" PRIx64 " (recorded %016" PRIx64
+			"), player %016" PRIx64 " (recorded %016" PRIx64 ") at (%f, %f) moving (%f, %f)\033[0m",
+			mMatched ? "\033[32m" : "\033[31m", mFrames, mExpected.mFrames, mPath.data(), world,
+			mExpected.mWorld, state, mExpected.mPlayer, position.x(), position.y(), velocity.x(),
+			velocity.y());
+
+		report();
+	}
+
+	close();
+}
+
+void ReplayManager::report() {
+	if (mTimes.empty()) {
+		return;
+	}
+
+	// Frame by frame, to compare two builds on the same replay
+	const std::string path = mPath + ".frames.csv";
+	if (SDL_IOStream* const csv = SDL_IOFromFile(path.data(), "w"); csv != nullptr) {
+		SDL_IOprintf(csv, "frame,ns\n");
+		for (std::size_t i = 0; i < mTimes.size(); ++i) {
+			SDL_IOprintf(csv, "%zu,%" PRIu64 "\n", i, mTimes[i]);
+		}
+
+		SDL_CloseIO(csv);
+	}
+
+	std::vector<std::uint64_t> sorted = mTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	std::uint64_t total = 0;
+	for (const auto time : sorted) {
+		total += time;
+	}
+
+	SDL_Log("Frame times: avg %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms, written to %s",
+		static_cast<double>(total) / sorted.size() / 1e6, sorted[sorted.size() / 2] / 1e6,
+		sorted[(sorted.size() - 1) * 99 / 100] / 1e6, sorted.back() / 1e6, path.data());
+}
+
+void ReplayManager::close() {
+	if (mFile != nullptr) {
+		SDL_CloseIO(mFile);
+		mFile = nullptr;
+	}
+}
+
+std::uint64_t ReplayManager::getTicks() {
+	const ReplayManager* const replay = Game::getInstance()->getReplayManager();
+	if (replay == nullptr || replay->mMode == Mode::NONE) {
+		return SDL_GetTicks();
+	}
+
+	return replay->mTicks;
+}
+
+SDL_MouseButtonFlags ReplayManager::getMouseState(float* const x, float* const y) {
+	const ReplayManager* const replay = Game::getInstance()->getReplayManager();
+	if (replay == nullptr || replay->mMode == Mode::NONE) {
+		return SDL_GetMouseState(x, y);
+	}
+
+	if (x != nullptr) {
+		*x = replay->mMouseX;
+	}
+
+	if (y != nullptr) {
+		*y = replay->mMouseY;
+	}
+
+	return replay->mButtons;
+}
+
+std::uint64_t ReplayManager::hashWorld(Scene* scene) {
+	// Summed, so the order of the views doesn't matter
+	std::uint64_t hash = 0;
+
+	for (const auto& [entity, block] : scene->view<Components::block>().each()) {
+		hash += hashValues({static_cast<std::uint64_t>(block.mType),
+				    static_cast<std::uint64_t>(block.mPosition.x()),
+				    static_cast<std::uint64_t>(block.mPosition.y())});
+	}
+
+	for (const auto& [entity, position] : scene->view<Components::position>().each()) {
+		hash += hashValues({entity, floatBits(position.mPosition.x()), floatBits(position.mPosition.y())});
+	}
+
+	return hash;
+}
+
+std::uint64_t ReplayManager::hashPlayer(Scene* scene, const EntityID player) {
+	const Eigen::Vector2f& position = scene->get<Components::position>(player).mPosition;
+	const Eigen::Vector2f& velocity = scene->get<Components::velocity>(player).mVelocity;
+
+	// The items, as they would get saved
+	rapidjson::Document items;
+	items.SetObject();
+	scene->get<Components::inventory>(player).mInventory->save(items, items.GetAllocator());
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	items.Accept(writer);
+
+	std::uint64_t hash = hashValues({floatBits(position.x()), floatBits(position.y()), floatBits(velocity.x()),
+					 floatBits(velocity.y()), static_cast<std::uint64_t>(scene->mMouse.item),
+					 scene->mMouse.count});
+	for (const char c : std::string_view(buffer.GetString(), buffer.GetSize())) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * FNV_PRIME;
+	}
+
+	return hash;
+}
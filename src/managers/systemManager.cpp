@@ -5,6 +5,7 @@
 #include "game.hpp"
 #include "managers/eventManager.hpp"
 #include "scene.hpp"
+#include "scenes/level.hpp"
 #include "systems/UISystem.hpp"
 #include "systems/inputSystem.hpp"
 #include "systems/physicsSystem.hpp"
@@ -105,7 +106,7 @@ template <EigenTypeMatExpr MatT> std::ostream& operator<<(std::ostream& os, cons
 SystemManager::SystemManager() noexcept
 	: mPhysicsSystem(std::make_unique<PhysicsSystem>()), mRenderSystem(std::make_unique<RenderSystem>()),
 	  mInputSystem(std::make_unique<InputSystem>()), mTextSystem(std::make_unique<TextSystem>()),
-	  mUISystem(std::make_unique<UISystem>()) {}
+	  mUISystem(std::make_unique<UISystem>()), mDrawScreens(false) {}
 
 SystemManager::~SystemManager() { SDL_Log("Unloading system"); }
 
@@ -123,29 +124,77 @@ Shader* SystemManager::getShader(const std::string& vert, const std::string& fra
 	return mRenderSystem->getShader(vert, frag, geom);
 }
 
-// 83.3% of the time
-void SystemManager::update(Scene* scene, const float delta) {
+void SystemManager::tick(Scene* scene, const float delta) {
 	SDL_assert(scene != nullptr);
 
-	mUISystem->update(scene, delta);
+	mInterpolated.clear();
+	for (const auto& [entity, position, _] : scene->view<Components::position, Components::velocity>().each()) {
+		mInterpolated.emplace_back(entity, position.mPosition, position.mPosition);
+	}
+
+	// Paused while a screen is open
+	if (!mUISystem->empty()) {
+		return;
+	}
+
+	mInputSystem->tick(scene, delta);
+
+	mPhysicsSystem->setCenter(Game::getInstance()->getLevel()->getPosition());
 	mPhysicsSystem->update(scene, delta); // 12.08%
 
 	mPhysicsSystem->collide(scene); // 33.72%
+}
+
+// 83.3% of the time
+void SystemManager::update(Scene* scene, const float delta, const float alpha) {
+	record(scene, delta, alpha);
+	submit(scene);
+	endFrame(scene);
+}
+
+void SystemManager::record(Scene* scene, const float delta, const float alpha) {
+	SDL_assert(scene != nullptr);
+
+	// The ticks can't touch the screens, what they opened gets added here
+	mUISystem->openRequested();
+	mUISystem->update(scene, delta);
 
 	updatePlayer(scene);
 
 	// This is after since it will delete stuff
 	mInputSystem->update(scene, delta);
 
-	mRenderSystem->draw(scene); // 36.51%
-	mInputSystem->draw(scene);
+	interpolate(scene, alpha);
+
+	mRenderSystem->record(scene); // 36.51%
+	mRenderSystem->beginPass(RenderSystem::Pass::TEXT);
 	mTextSystem->draw(scene);
-	mUISystem->draw(scene);
+	mRenderSystem->endPass();
+
+	restore(scene);
 
 	printDebug(scene);
+	mPhysicsSystem->editor(scene);
+
+	// A screen opened by the ticks shows up next frame, they can run while this one is submitted
+	mDrawScreens = !mUISystem->empty();
+}
+
+void SystemManager::submit(Scene* scene) {
+	mRenderSystem->draw();
+	mInputSystem->draw(scene);
+	mRenderSystem->flush();
+
+	if (mDrawScreens) {
+		mRenderSystem->beginPass(RenderSystem::Pass::UI);
+		mUISystem->draw(scene);
+		mRenderSystem->endPass();
+	}
 
 	mRenderSystem->present();
+}
 
+void SystemManager::endFrame(Scene* scene) {
 	scene->getSignal(EventManager::LEFT_CLICK_DOWN_SIGNAL) = false;
 	scene->getSignal(EventManager::RIGHT_CLICK_DOWN_SIGNAL) = false;
 }
@@ -177,6 +226,26 @@ void SystemManager::updatePlayer(Scene* scene) {
 	select(SDL_SCANCODE_9, 8);
 }
 
+void SystemManager::interpolate(Scene* scene, const float alpha) {
+	for (auto& entity : mInterpolated) {
+		if (!scene->contains<Components::position>(entity.mEntity)) {
+			continue;
+		}
+
+		auto& position = scene->get<Components::position>(entity.mEntity).mPosition;
+		entity.mCurrent = position;
+		position = entity.mPrevious + (entity.mCurrent - entity.mPrevious) * alpha;
+	}
+}
+
+void SystemManager::restore(Scene* scene) {
+	for (const auto& entity : mInterpolated) {
+		if (scene->contains<Components::position>(entity.mEntity)) {
+			scene->get<Components::position>(entity.mEntity).mPosition = entity.mCurrent;
+		}
+	}
+}
+
 void SystemManager::printDebug([[maybe_unused]] Scene* scene) {
 #ifdef IMGUI
 	// Print out signals
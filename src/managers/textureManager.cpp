@@ -1,48 +1,65 @@
 #include "managers/textureManager.hpp"
 
-#include "components.hpp"
-#include "game.hpp"
-#include "items.hpp"
-#include "managers/systemManager.hpp"
-#include "opengl/mesh.hpp"
-#include "opengl/shader.hpp"
 #include "opengl/texture.hpp"
-#include "registers.hpp"
-#include "systems/UISystem.hpp"
-#include "systems/renderSystem.hpp"
-#include "third_party/glad/glad.h"
+#include "third_party/Eigen/Core"
+#include "third_party/rapidjson/document.h"
 #include "third_party/stb_image.h"
 #include "utils.hpp"
 
-#include <cstdint>
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <unordered_map>
-#include <version>
-
-TextureManager::TextureManager()
-	: mPath(getBasePath() + "assets/textures/"), mBlitzed(new bool[etoi(Components::Item::ITEM_COUNT)]) {
-	for (std::uint64_t i = 0; i < etoi(Components::Item::ITEM_COUNT); ++i) {
-		mBlitzed[i] = 0;
-	}
 
+TextureManager::TextureManager() : mPath(getBasePath() + "assets/textures/") {
 	// OpenGL wants this
 	stbi_set_flip_vertically_on_load(false);
 	get("missing-texture.png");
 
-	mAtlas = new Texture(Eigen::Vector2i(1024, 1024));
-	glGenFramebuffers(1, &mAtlasBuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, mAtlasBuffer);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mAtlas->mID, 0);
+	loadAtlas();
+}
+
+void TextureManager::loadAtlas() {
+	std::size_t size = 0;
+	const std::unique_ptr<char[], void (*)(void*)> data(
+		static_cast<char*>(loadFile((mPath + ATLAS_FILE).data(), &size)), SDL_free);
+
+	rapidjson::Document atlas;
+	if (!data || atlas.Parse(data.get(), size).HasParseError()) {
+		SDL_LogCritical(SDL_LOG_CATEGORY_VIDEO, "\033[31mFailed to read the texture atlas %s\033[0m",
+				ATLAS_FILE);
+		ERROR_BOX("Failed to read the texture atlas, reinstall assets");
+
+		return;
+	}
+
+	mPages.clear();
+	for (const auto& page : atlas["pages"].GetArray()) {
+		mPages.emplace_back(get(page["file"].GetString()));
+	}
 
-	constexpr const GLenum buffers = GL_COLOR_ATTACHMENT0;
-	glDrawBuffers(1, &buffers);
+	mRegions.clear();
+	mTextureRegions.clear();
+	for (const auto& texture : atlas["textures"].GetObject()) {
+		const auto& rect = texture.value.GetArray();
+		const Eigen::Vector2f page =
+			Eigen::Vector2f(atlas["pages"][rect[0].GetUint()]["width"].GetFloat(),
+					atlas["pages"][rect[0].GetUint()]["height"].GetFloat());
+
+		mRegions.try_emplace(texture.name.GetString(), mPages[rect[0].GetUint()],
+				     Eigen::Vector4f(rect[1].GetFloat() / page.x(), rect[2].GetFloat() / page.y(),
+						     rect[3].GetFloat() / page.x(), rect[4].GetFloat() / page.y()));
+	}
 
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-		SDL_LogCritical(SDL_LOG_CATEGORY_VIDEO, "\033[31mFailed to make texture atlas\033[0m");
-		ERROR_BOX("Failed to make texture atlas! Check your opengl.");
+	// Textures loaded before the atlas
+	for (const auto& [name, texture] : mTextures) {
+		if (const auto region = mRegions.find(name); region != mRegions.end()) {
+			mTextureRegions[texture] = &region->second;
+		}
 	}
 
-	glClearColor(0, 0, 0, 0);
-	glClear(GL_COLOR_BUFFER_BIT);
+	SDL_Log("Loaded texture atlas: %zu textures in %zu pages", mRegions.size(), mPages.size());
 }
 
 // TODO: Unloading when out of memory
@@ -56,7 +73,6 @@ TextureManager::~TextureManager() {
 	}
 
 	delete missing;
-	delete mAtlas;
 }
 
 Texture* TextureManager::get(const std::string& name, const bool srgb) {
@@ -70,6 +86,8 @@ Texture* TextureManager::get(const std::string& name, const bool srgb) {
 
 		delete texture;
 		texture = get("missing-texture.png");
+	} else if (const auto region = mRegions.find(name); region != mRegions.end()) {
+		mTextureRegions[texture] = &region->second;
 	}
 
 	mTextures[name] = texture;
@@ -77,31 +95,16 @@ Texture* TextureManager::get(const std::string& name, const bool srgb) {
 	return texture;
 }
 
-class Texture* TextureManager::getAtlas() { return mAtlas; }
-
-void TextureManager::blitzAtlas(Components::Item block) {
-	// Atlas contains texture
-	if (mBlitzed[etoi(block)]) {
-		return;
-	}
-
-	glBindFramebuffer(GL_FRAMEBUFFER, mAtlasBuffer);
-	// Alr activated in render system
-	Shader* const shader = Game::getInstance()->getSystemManager()->getShader("blitz.vert", "block.frag");
-
-	// Set this only once
-	static bool s = false;
-	if (!s) {
-		shader->set("texture_diffuse"_u, 0);
-		s = true;
-	}
-	shader->set("position"_u, static_cast<int>(etoi(block)));
+const TextureManager::Region* TextureManager::getRegion(const std::string& name) const {
+	const auto region = mRegions.find(name);
 
-	get(registers::TEXTURES.at(block))->activate(0);
+	return region == mRegions.end() ? nullptr : &region->second;
+}
 
-	Game::getInstance()->getSystemManager()->getUISystem()->getMesh()->draw(shader);
+const TextureManager::Region* TextureManager::getRegion(const Texture* const texture) const {
+	const auto region = mTextureRegions.find(texture);
 
-	mBlitzed[etoi(block)] = true;
+	return region == mTextureRegions.end() ? nullptr : region->second;
 }
 
 void TextureManager::reload() {
@@ -110,4 +113,6 @@ void TextureManager::reload() {
 		auto* newTexture = new Texture(mPath + name);
 		texture = newTexture;
 	}
+
+	loadAtlas();
 }
@@ -0,0 +1,63 @@
+#include "opengl/chunkMesh.hpp"
+
+#include "opengl/mesh.hpp"
+#include "third_party/glad/glad.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+ChunkMesh::ChunkMesh() : mBuffer(0), mCapacity(0) { glGenBuffers(1, &mBuffer); }
+
+ChunkMesh::~ChunkMesh() { glDeleteBuffers(1, &mBuffer); }
+
+void ChunkMesh::update(const std::span<const Instance> instances) {
+	glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+
+	// Only the blocks outside of the grid change the size, leave some room for them
+	if (instances.size() > mCapacity) {
+		mCapacity = instances.size() + instances.size() / 8;
+		mInstances.assign(instances.begin(), instances.end());
+
+		glBufferData(GL_ARRAY_BUFFER, mCapacity * sizeof(Instance), nullptr, GL_DYNAMIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size_bytes(), instances.data());
+
+		return;
+	}
+
+	// Upload from the first to the last instance that changed
+	std::size_t first = 0;
+	const std::size_t common = std::min(instances.size(), mInstances.size());
+	while (first < common && instances[first] == mInstances[first]) {
+		++first;
+	}
+
+	std::size_t last = instances.size();
+	if (instances.size() == mInstances.size()) {
+		while (last > first && instances[last - 1] == mInstances[last - 1]) {
+			--last;
+		}
+	}
+
+	mInstances.assign(instances.begin(), instances.end());
+	if (first == last) {
+		return;
+	}
+
+	glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Instance), (last - first) * sizeof(Instance),
+			instances.data() + first);
+}
+
+void ChunkMesh::draw(Mesh* const mesh) const {
+	if (mInstances.empty()) {
+		return;
+	}
+
+	mesh->bindAttribArray(mBuffer, 0, [](const GLintptr offset) {
+		glEnableVertexAttribArray(3);
+		glVertexAttribIPointer(3, 4, GL_INT, sizeof(Instance), reinterpret_cast<GLvoid*>(offset));
+		glVertexAttribDivisor(3, 1);
+	});
+
+	mesh->drawInstanced(mInstances.size());
+}
@@ -1,5 +1,6 @@
 #include "opengl/framebuffer.hpp"
 
+#include "opengl/glState.hpp"
 #include "opengl/mesh.hpp"
 #include "opengl/shader.hpp"
 #include "systems/renderSystem.hpp"
@@ -7,16 +8,21 @@
 #include "utils.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <span>
 #include <string>
+#include <vector>
 
 #ifdef IMGUI
 #include <backends/imgui_impl_opengl3.h>
 #include <imgui.h>
 #endif
 
-Framebuffer::Framebuffer(RenderSystem* owner) : mOwner(owner), mScreen(0), mScreenTexture(0) {
+Framebuffer::Framebuffer(RenderSystem* owner)
+	: mOwner(owner), mScreen(0), mScreenTexture(0), mWidth(1024), mHeight(768) {
 	SDL_Log("Framebuffer.cpp: Generating framebuffer");
 
 	SDL_assert(glGenFramebuffers != nullptr);
@@ -25,13 +31,13 @@ Framebuffer::Framebuffer(RenderSystem* owner) : mOwner(owner), mScreen(0), mScre
 	glBindFramebuffer(GL_FRAMEBUFFER, mScreen);
 
 	glGenTextures(1, &mScreenTexture);
-	glBindTexture(GL_TEXTURE_2D, mScreenTexture);
+	GLState::bindTexture(0, mScreenTexture);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1024, 768, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mWidth, mHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::bindTexture(0, 0);
 
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mScreenTexture, 0);
 
@@ -54,17 +60,18 @@ Framebuffer::Framebuffer(RenderSystem* owner) : mOwner(owner), mScreen(0), mScre
 	mShader->activate();
 	mShader->set("screen"_u, 0);
 
-	glActiveTexture(GL_TEXTURE0);
-
 	mScreenMesh = std::make_unique<Mesh>(pos, std::span<float>(), std::span<float>(), indices);
 }
 
 void Framebuffer::bind() const { glBindFramebuffer(GL_FRAMEBUFFER, mScreen); }
 
 void Framebuffer::setDemensions(const int width, const int height) {
-	glBindTexture(GL_TEXTURE_2D, mScreenTexture);
+	mWidth = width;
+	mHeight = height;
+
+	GLState::bindTexture(0, mScreenTexture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::bindTexture(0, 0);
 }
 
 void Framebuffer::swap() {
@@ -84,18 +91,20 @@ void Framebuffer::swap() {
 	glClear(GL_COLOR_BUFFER_BIT);
 #endif
 
-	glDisable(GL_BLEND);
+	GLState::blend(false);
 
 	Shader* mShader = mOwner->getShader("framebuffer.vert", "framebuffer.frag");
 	mShader->activate();
 
-	glBindTexture(GL_TEXTURE_2D, mScreenTexture);
+	GLState::bindTexture(0, mScreenTexture);
 
 	mScreenMesh->draw(mShader);
 
 #ifdef IMGUI
 	ImGui::Render();
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	// ImGui puts back what it changed, but not through the cache
+	GLState::invalidate();
 #endif
 
 	mOwner->swapWindow();
@@ -109,6 +118,24 @@ void Framebuffer::swap() {
 #endif
 }
 
+std::vector<std::uint8_t> Framebuffer::read() const {
+	const std::size_t stride = static_cast<std::size_t>(mWidth) * 4;
+	std::vector<std::uint8_t> pixels(stride * mHeight);
+
+	// RGBA is the only format GLES has to read back
+	glBindFramebuffer(GL_FRAMEBUFFER, mScreen);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, mWidth, mHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	// GL starts at the bottom
+	for (int y = 0; y < mHeight / 2; ++y) {
+		std::swap_ranges(pixels.begin() + y * stride, pixels.begin() + (y + 1) * stride,
+				 pixels.begin() + (mHeight - 1 - y) * stride);
+	}
+
+	return pixels;
+}
+
 Framebuffer::~Framebuffer() {
 	glDeleteTextures(1, &mScreenTexture);
 	glDeleteFramebuffers(1, &mScreen);
@@ -0,0 +1,92 @@
+#include "opengl/glState.hpp"
+
+#include "third_party/glad/glad.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+
+void GLState::useProgram(const GLuint program) {
+	if (mProgram == program) {
+		++mStats.mSkipped;
+
+		return;
+	}
+
+	glUseProgram(program);
+	mProgram = program;
+	++mStats.mPrograms;
+}
+
+void GLState::bindTexture(const GLuint unit, const GLuint texture) {
+	SDL_assert(unit < TEXTURE_UNITS && "Texture unit out of range");
+
+	if (mActiveUnit == unit && mTextures[unit] == texture) {
+		++mStats.mSkipped;
+
+		return;
+	}
+
+	if (mActiveUnit != unit) {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		mActiveUnit = unit;
+	}
+
+	// Other textures can be bound on the unit we switched to
+	if (mTextures[unit] != texture) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+		mTextures[unit] = texture;
+		++mStats.mTextures;
+	}
+}
+
+void GLState::bindVertexArray(const GLuint vertexArray) {
+	if (mVertexArray == vertexArray) {
+		++mStats.mSkipped;
+
+		return;
+	}
+
+	glBindVertexArray(vertexArray);
+	mVertexArray = vertexArray;
+	++mStats.mVertexArrays;
+}
+
+void GLState::blend(const bool enabled) {
+	if (mBlend == static_cast<GLuint>(enabled)) {
+		++mStats.mSkipped;
+
+		return;
+	}
+
+	if (enabled) {
+		glEnable(GL_BLEND);
+	} else {
+		glDisable(GL_BLEND);
+	}
+
+	mBlend = enabled;
+	++mStats.mBlends;
+}
+
+void GLState::blendFunc(const GLenum source, const GLenum destination) {
+	if (mBlendSource == source && mBlendDestination == destination) {
+		++mStats.mSkipped;
+
+		return;
+	}
+
+	glBlendFunc(source, destination);
+	mBlendSource = source;
+	mBlendDestination = destination;
+	++mStats.mBlends;
+}
+
+void GLState::invalidate() {
+	mProgram = UNKNOWN;
+	mActiveUnit = UNKNOWN;
+	std::ranges::fill(mTextures, UNKNOWN);
+	mVertexArray = UNKNOWN;
+	mBlend = UNKNOWN;
+	mBlendSource = UNKNOWN;
+	mBlendDestination = UNKNOWN;
+}
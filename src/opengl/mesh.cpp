@@ -1,5 +1,6 @@
 #include "opengl/mesh.hpp"
 
+#include "opengl/glState.hpp"
 #include "opengl/shader.hpp"
 #include "opengl/texture.hpp"
 #include "opengl/types.hpp"
@@ -21,7 +22,7 @@ Mesh::Mesh(const std::span<const Vertex> vertices, const std::span<const GLuint>
 
 	glGenVertexArrays(1, &mVAO);
 
-	glBindVertexArray(mVAO);
+	GLState::bindVertexArray(mVAO);
 
 	// Bind all the vertex data
 	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
@@ -42,7 +43,7 @@ Mesh::Mesh(const std::span<const Vertex> vertices, const std::span<const GLuint>
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndicesCount * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
 
-	glBindVertexArray(0);
+	GLState::bindVertexArray(0);
 }
 
 Mesh::Mesh(const std::span<const float> positions, const std::span<const float> normals,
@@ -61,7 +62,7 @@ Mesh::Mesh(const std::span<const float> positions, const std::span<const float>
 	std::size_t offset = 0;
 
 	// TODO: Prettier
-	glBindVertexArray(mVAO);
+	GLState::bindVertexArray(mVAO);
 	glEnableVertexAttribArray(0);
 	// Enable no matter what
 	// https://developer.mozilla.org/en-US/docs/Web/API/WebGL_API/WebGL_best_practices#always_enable_vertex_attrib_0_as_an_array
@@ -102,6 +103,7 @@ Mesh::Mesh(const std::span<const float> positions, const std::span<const float>
 
 Mesh::~Mesh() {
 	glDeleteVertexArrays(1, &mVAO);
+	GLState::invalidate();
 	glDeleteBuffers(1, &mVBO);
 	glDeleteBuffers(1, &mEBO);
 
@@ -161,7 +163,7 @@ void Mesh::addAttribArray(const GLsizeiptr size, const GLvoid* const data, void
 void Mesh::addAttribArray(const GLuint VBO, void (*bind)()) {
 	SDL_assert(glIsBuffer(VBO));
 
-	glBindVertexArray(mVAO); // Save it in vertex array
+	GLState::bindVertexArray(mVAO); // Save it in vertex array
 
 	glBindBuffer(GL_ARRAY_BUFFER, VBO); // Be sure our VAO contains the VBO
 
@@ -170,12 +172,23 @@ void Mesh::addAttribArray(const GLuint VBO, void (*bind)()) {
 	mAttribs.emplace_back(VBO);
 }
 
+void Mesh::bindAttribArray(const GLuint VBO, const GLintptr offset, void (*bind)(GLintptr offset)) {
+	SDL_assert(glIsBuffer(VBO));
+
+	GLState::bindVertexArray(mVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	bind(offset);
+}
+
 void Mesh::draw(Shader*) {
-	glBindVertexArray(mVAO);
+	GLState::bindVertexArray(mVAO);
 	glDrawElements(GL_TRIANGLES, mIndicesCount, GL_UNSIGNED_INT, nullptr);
+	GLState::countDraw();
 }
 
 void Mesh::drawInstanced(const GLsizei count) {
-	glBindVertexArray(mVAO);
+	GLState::bindVertexArray(mVAO);
 	glDrawElementsInstanced(GL_TRIANGLES, mIndicesCount, GL_UNSIGNED_INT, nullptr, count);
+	GLState::countDraw();
 }
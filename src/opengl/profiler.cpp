@@ -0,0 +1,298 @@
+#include "opengl/profiler.hpp"
+
+#include "third_party/glad/glad.h"
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <cfloat>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef IMGUI
+#include <imgui.h>
+#endif
+
+Profiler::Profiler()
+	: mTimerQueries(false), mFinish(false), mFrame(0), mSlots(), mPass(Pass::COUNT), mStart(0), mCPU(), mGPU(),
+	  mCurrentCPU(), mCurrentGPU(), mHistory(HISTORY, Sample{~0ull, {}, {}}) {
+#ifdef GLES
+	// GLES only has them with the extension
+	mTimerQueries = GLAD_GL_EXT_disjoint_timer_query && glGetQueryObjectui64v != nullptr;
+#else
+	mTimerQueries = (GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_timer_query) && glGetQueryObjectui64v != nullptr;
+#endif
+
+	if (!mTimerQueries) {
+		SDL_Log("\033[33mProfiler.cpp: No timer queries, GPU times are off\033[0m");
+	}
+
+	mHistory[0].mFrame = 0;
+}
+
+Profiler::~Profiler() {
+	for (Slot& slot : mSlots) {
+		if (!slot.mQueries.empty()) {
+			glDeleteQueries(static_cast<GLsizei>(slot.mQueries.size()), slot.mQueries.data());
+		}
+	}
+}
+
+void Profiler::frame() {
+	end();
+
+	mCPU = mCurrentCPU;
+	mCurrentCPU.fill(0);
+
+	Sample* const sample = getSample(mFrame);
+	if (sample != nullptr) {
+		sample->mCPU = mCPU;
+	}
+
+	// Finished passes have their GPU times right away
+	if (!mTimerQueries) {
+		mGPU = mCurrentGPU;
+		mCurrentGPU.fill(0);
+
+		if (sample != nullptr) {
+			sample->mGPU = mGPU;
+		}
+	}
+
+	++mFrame;
+	mHistory[mFrame % HISTORY] = Sample{mFrame, {}, {}};
+
+	// The slot was used LATENCY frames ago
+	Slot& slot = mSlots[mFrame % LATENCY];
+	readBack(slot);
+
+	slot.mFrame = mFrame;
+	slot.mPasses.clear();
+}
+
+void Profiler::begin(const Pass pass) {
+	end();
+
+	mPass = pass;
+
+	if (mTimerQueries) {
+		Slot& slot = mSlots[mFrame % LATENCY];
+		if (slot.mPasses.size() == slot.mQueries.size()) {
+			GLuint query;
+			glGenQueries(1, &query);
+			slot.mQueries.emplace_back(query);
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, slot.mQueries[slot.mPasses.size()]);
+		slot.mPasses.emplace_back(pass);
+	} else if (mFinish) {
+		// Don't count what the pass before left
+		glFinish();
+	}
+
+	mStart = SDL_GetTicksNS();
+}
+
+void Profiler::end() {
+	if (mPass == Pass::COUNT) {
+		return;
+	}
+
+	const std::size_t pass = static_cast<std::size_t>(mPass);
+	mCurrentCPU[pass] += SDL_GetTicksNS() - mStart;
+	mPass = Pass::COUNT;
+
+	if (mTimerQueries) {
+		glEndQuery(GL_TIME_ELAPSED);
+	} else if (mFinish) {
+		glFinish();
+		mCurrentGPU[pass] += SDL_GetTicksNS() - mStart;
+	}
+}
+
+void Profiler::readBack(Slot& slot) {
+	if (slot.mPasses.empty()) {
+		return;
+	}
+
+	// They finish in order, if the last one's done they all are
+	// If it isn't the frame is dropped instead of waiting for it
+	GLuint available = GL_FALSE;
+	glGetQueryObjectuiv(slot.mQueries[slot.mPasses.size() - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (available == GL_FALSE) {
+		return;
+	}
+
+#ifdef GLES
+	// Something reset the GPU clock, the results are garbage
+	GLint disjoint = GL_FALSE;
+	glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+	if (disjoint) {
+		return;
+	}
+#endif
+
+	Times times = {};
+	for (std::size_t i = 0; i < slot.mPasses.size(); ++i) {
+		GLuint64 time = 0;
+		glGetQueryObjectui64v(slot.mQueries[i], GL_QUERY_RESULT, &time);
+
+		times[static_cast<std::size_t>(slot.mPasses[i])] += time;
+	}
+
+	mGPU = times;
+	if (Sample* const sample = getSample(slot.mFrame); sample != nullptr) {
+		sample->mGPU = times;
+	}
+}
+
+Profiler::Sample* Profiler::getSample(const std::uint64_t frame) {
+	Sample& sample = mHistory[frame % HISTORY];
+
+	return sample.mFrame == frame ? &sample : nullptr;
+}
+
+const char* Profiler::getName(const Pass pass) {
+	switch (pass) {
+		case Pass::UPLOAD:
+			return "Upload";
+		case Pass::BLOCKS:
+			return "Blocks";
+		case Pass::SPRITES:
+			return "Sprites";
+		case Pass::HUD:
+			return "HUD";
+		case Pass::TEXT:
+			return "Text";
+		case Pass::UI:
+			return "UI";
+		case Pass::PRESENT:
+			return "Present";
+		case Pass::COUNT:
+			break;
+	}
+
+	return "Unknown";
+}
+
+bool Profiler::save(const std::string& path) const {
+	SDL_IOStream* const csv = SDL_IOFromFile(path.data(), "w");
+	if (csv == nullptr) {
+		SDL_Log("\033[33mProfiler.cpp: Failed to open %s: %s\033[0m", path.data(), SDL_GetError());
+
+		return false;
+	}
+
+	SDL_IOprintf(csv, "frame");
+	for (const char* const kind : {"cpu", "gpu"}) {
+		for (std::size_t pass = 0; pass < PASSES; ++pass) {
+			SDL_IOprintf(csv, ",%s %s us", getName(static_cast<Pass>(pass)), kind);
+		}
+	}
+	SDL_IOprintf(csv, "\n");
+
+	// Oldest first, the current frame isn't done
+	for (std::uint64_t frame = mFrame > HISTORY ? mFrame - HISTORY + 1 : 0; frame < mFrame; ++frame) {
+		const Sample& sample = mHistory[frame % HISTORY];
+		if (sample.mFrame != frame) {
+			continue;
+		}
+
+		SDL_IOprintf(csv, "%" PRIu64, frame);
+		for (const Times* const times : {&sample.mCPU, &sample.mGPU}) {
+			for (const std::uint64_t time : *times) {
+				SDL_IOprintf(csv, ",%.3f", time / 1000.0);
+			}
+		}
+		SDL_IOprintf(csv, "\n");
+	}
+
+	return SDL_CloseIO(csv);
+}
+
+void Profiler::gui() {
+#ifdef IMGUI
+	ImGui::Begin("Profiler");
+
+	if (!mTimerQueries) {
+		ImGui::TextUnformatted("No timer queries on this GPU");
+		ImGui::Checkbox("Finish every pass for the GPU times (slow)", &mFinish);
+	}
+
+	// Averages over the history, the GPU ones only count the frames that got read back
+	std::array<double, PASSES> cpu = {};
+	std::array<double, PASSES> gpu = {};
+	std::array<float, HISTORY> cpuFrames = {};
+	std::array<float, HISTORY> gpuFrames = {};
+	std::size_t cpuCount = 0;
+	std::size_t gpuCount = 0;
+	for (std::size_t i = 0; i < HISTORY; ++i) {
+		// The last HISTORY frames before this one
+		if (mFrame + i < HISTORY) {
+			continue;
+		}
+
+		const std::uint64_t frame = mFrame + i - HISTORY;
+		const Sample& sample = mHistory[frame % HISTORY];
+		if (sample.mFrame != frame) {
+			continue;
+		}
+
+		std::uint64_t cpuTotal = 0;
+		std::uint64_t gpuTotal = 0;
+		for (std::size_t pass = 0; pass < PASSES; ++pass) {
+			cpu[pass] += sample.mCPU[pass];
+			gpu[pass] += sample.mGPU[pass];
+			cpuTotal += sample.mCPU[pass];
+			gpuTotal += sample.mGPU[pass];
+		}
+
+		cpuFrames[i] = cpuTotal / 1e6f;
+		gpuFrames[i] = gpuTotal / 1e6f;
+		++cpuCount;
+		gpuCount += gpuTotal != 0;
+	}
+
+	if (ImGui::BeginTable("Passes", 3, ImGuiTableFlags_Borders)) {
+		ImGui::TableSetupColumn("Pass");
+		ImGui::TableSetupColumn("CPU ms");
+		ImGui::TableSetupColumn("GPU ms");
+		ImGui::TableHeadersRow();
+
+		for (std::size_t pass = 0; pass < PASSES; ++pass) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(getName(static_cast<Pass>(pass)));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", cpuCount == 0 ? 0.0 : cpu[pass] / cpuCount / 1e6);
+			ImGui::TableNextColumn();
+			if (gpuCount == 0) {
+				ImGui::TextUnformatted("-");
+			} else {
+				ImGui::Text("%.3f", gpu[pass] / gpuCount / 1e6);
+			}
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::PlotLines("CPU ms", cpuFrames.data(), HISTORY, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+	if (hasGPUTimes()) {
+		ImGui::PlotLines("GPU ms", gpuFrames.data(), HISTORY, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+	}
+
+	if (ImGui::Button("Save to csv")) {
+		char* const pref = SDL_GetPrefPath("cyao", "opengl");
+		const std::string path = std::string(pref != nullptr ? pref : "") + "profile.csv";
+		SDL_free(pref);
+
+		if (save(path)) {
+			SDL_Log("Saved the profile to %s", path.data());
+		}
+	}
+
+	ImGui::End();
+#endif
+}
@@ -0,0 +1,119 @@
+#include "opengl/renderQueue.hpp"
+
+#include "opengl/glState.hpp"
+#include "opengl/mesh.hpp"
+#include "opengl/shader.hpp"
+#include "opengl/texture.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/glad/glad.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <variant>
+
+RenderQueue::Submission& RenderQueue::Submission::set(const std::uint64_t name, const GLint value) {
+	mQueue->mUniforms.emplace_back(name, value);
+	++mQueue->mCommands.back().mUniforms;
+
+	return *this;
+}
+
+RenderQueue::Submission& RenderQueue::Submission::set(const std::uint64_t name, const GLfloat value) {
+	mQueue->mUniforms.emplace_back(name, value);
+	++mQueue->mCommands.back().mUniforms;
+
+	return *this;
+}
+
+RenderQueue::Submission& RenderQueue::Submission::set(const std::uint64_t name, const GLfloat value,
+							 const GLfloat value2) {
+	return set(name, Eigen::Vector2f(value, value2));
+}
+
+RenderQueue::Submission& RenderQueue::Submission::set(const std::uint64_t name, const Eigen::Vector2f& value) {
+	mQueue->mUniforms.emplace_back(name, value);
+	++mQueue->mCommands.back().mUniforms;
+
+	return *this;
+}
+
+RenderQueue::Submission& RenderQueue::Submission::set(const std::uint64_t name, const Eigen::Vector3f& value) {
+	mQueue->mUniforms.emplace_back(name, value);
+	++mQueue->mCommands.back().mUniforms;
+
+	return *this;
+}
+
+RenderQueue::RenderQueue() {}
+
+RenderQueue::~RenderQueue() {}
+
+RenderQueue::Submission RenderQueue::submit(const Pass pass, const int layer, Shader* const shader,
+					    const Texture* const texture, Mesh* const mesh, const bool blend) {
+	SDL_assert(shader != nullptr && mesh != nullptr);
+
+	mCommands.emplace_back(pass, layer, shader, texture, mesh, blend, mCommands.size(), mUniforms.size(), 0);
+
+	return Submission(this);
+}
+
+void RenderQueue::flush(const std::function<void(Pass)>& passBegin) {
+	if (mCommands.empty()) {
+		return;
+	}
+
+	std::ranges::sort(mCommands, [](const Command& a, const Command& b) {
+		if (a.mPass != b.mPass) {
+			return a.mPass < b.mPass;
+		}
+
+		if (a.mLayer != b.mLayer) {
+			return a.mLayer < b.mLayer;
+		}
+
+		if (a.mShader != b.mShader) {
+			return std::less<const Shader*>()(a.mShader, b.mShader);
+		}
+
+		if (a.mTexture != b.mTexture) {
+			return std::less<const Texture*>()(a.mTexture, b.mTexture);
+		}
+
+		if (a.mMesh != b.mMesh) {
+			return std::less<const Mesh*>()(a.mMesh, b.mMesh);
+		}
+
+		return a.mSequence < b.mSequence;
+	});
+
+	for (std::size_t i = 0; i < mCommands.size(); ++i) {
+		const Command& command = mCommands[i];
+		if (passBegin && (i == 0 || command.mPass != mCommands[i - 1].mPass)) {
+			passBegin(command.mPass);
+		}
+
+		GLState::blend(command.mBlend);
+		if (command.mBlend) {
+			GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		command.mShader->activate();
+		if (command.mTexture != nullptr) {
+			command.mTexture->activate(0);
+		}
+
+		for (std::size_t uniform = command.mFirstUniform; uniform < command.mFirstUniform + command.mUniforms;
+		     ++uniform) {
+			std::visit([&](const auto& value) { command.mShader->set(mUniforms[uniform].mName, value); },
+				   mUniforms[uniform].mValue);
+		}
+
+		command.mMesh->draw(command.mShader);
+	}
+
+	mCommands.clear();
+	mUniforms.clear();
+}
@@ -1,15 +1,17 @@
 #include "opengl/shader.hpp"
 
+#include "opengl/glState.hpp"
 #include "third_party/Eigen/Dense"
 #include "third_party/glad/glad.h"
 #include "utils.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <cinttypes>
 #include <cstddef>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 std::uint64_t crc32(const char* str, std::size_t len) {
@@ -24,7 +26,7 @@ std::uint64_t crc32(const char* str, std::size_t len) {
 	return crc ^ 0xFFFFFFFF;
 }
 
-Shader::Shader() : mName(), mShaderProgram(glCreateProgram()) {}
+Shader::Shader() : mName(), mShaderProgram(glCreateProgram()) { mLocations.fill(-1); }
 
 bool Shader::load(std::string_view vertName, std::string_view fragName, std::string_view geomName) {
 	mName = (std::string(vertName) + ":" + std::string(fragName) + ":" + std::string(geomName));
@@ -70,7 +72,13 @@ bool Shader::load(std::string_view vertName, std::string_view fragName, std::str
 		return false;
 	}
 
-	bind("Matrices", 0);
+	// Bound by the render system, only the blocks use the atlas
+	constexpr const static std::pair<const char*, GLuint> blocks[] = {{"Matrices", 0}, {"Atlas", 1}, {"Frame", 2}};
+	for (const auto& [block, index] : blocks) {
+		if (glGetUniformBlockIndex(mShaderProgram, block) != GL_INVALID_INDEX) {
+			bind(block, index);
+		}
+	}
 
 	GLint maxLen, uniformCount;
 	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
@@ -85,9 +93,22 @@ bool Shader::load(std::string_view vertName, std::string_view fragName, std::str
 		glGetActiveUniform(mShaderProgram, i, maxLen + 2, &len, nullptr, &type, uniform.data());
 		len += 1;
 
-		std::uint64_t hash = crc32(uniform.data(), len);
+		const std::uint64_t hash = crc32(uniform.data(), len);
+		const GLint location = glGetUniformLocation(mShaderProgram, uniform.data());
+
+		// In a uniform block
+		if (location == -1) {
+			continue;
+		}
+
+		if (const UniformSlot slot = uniformSlot(hash); slot != UniformSlot::NONE) {
+			mLocations[static_cast<std::size_t>(slot)] = location;
+		} else {
+			SDL_Log("\033[33mShader.cpp: Uniform %s of shader %s has no slot\033[0m", uniform.data(),
+				mName.data());
 
-		mPositionCache[hash] = glGetUniformLocation(mShaderProgram, uniform.data());
+			mOtherLocations.emplace_back(hash, location);
+		}
 	}
 
 #ifdef DEBUG
@@ -107,24 +128,26 @@ bool Shader::load(std::string_view vertName, std::string_view fragName, std::str
 	return true;
 }
 
-Shader::~Shader() { glDeleteProgram(mShaderProgram); }
+Shader::~Shader() {
+	glDeleteProgram(mShaderProgram);
+	GLState::invalidate();
+}
+
+void Shader::activate() const noexcept { GLState::useProgram(mShaderProgram); }
 
-void Shader::activate() const noexcept { glUseProgram(mShaderProgram); }
+GLint Shader::getOtherUniform(const std::uint64_t name) const {
+	const auto uniform = std::ranges::find(mOtherLocations, name, &std::pair<std::uint64_t, GLint>::first);
+	[[likely]] if (uniform != mOtherLocations.end()) { return uniform->second; }
 
-GLint Shader::getUniform(const std::uint64_t name) const {
-	[[unlikely]] if (!mPositionCache.contains(name)) {
-		static std::unordered_map<std::uint64_t, bool> warned;
-		if (!warned[name]) {
-			SDL_Log("\033[93mShader.cpp: Failed to find uniform location with hash \"%" PRIu64
-				"\" for shader %s\033[0m",
-				name, mName.data());
-			warned[name] = true;
-		}
+	[[unlikely]] if (std::ranges::find(mMissing, name) == mMissing.end()) {
+		SDL_Log("\033[93mShader.cpp: Failed to find uniform location with hash \"%" PRIu64
+			"\" for shader %s\033[0m",
+			name, mName.data());
 
-		return -1;
+		mMissing.emplace_back(name);
 	}
 
-	return mPositionCache[name];
+	return -1;
 }
 
 void Shader::set(const std::uint64_t name, const GLboolean val) const {
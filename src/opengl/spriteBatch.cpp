@@ -0,0 +1,93 @@
+#include "opengl/spriteBatch.hpp"
+
+#include "opengl/mesh.hpp"
+#include "opengl/streamBuffer.hpp"
+#include "opengl/texture.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/glad/glad.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace {
+void bindInstances(const GLintptr offset) {
+	constexpr const GLsizei stride = 8 * sizeof(float);
+
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offset));
+	glVertexAttribDivisor(3, 1);
+
+	glEnableVertexAttribArray(4);
+	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid*>(offset + 4 * sizeof(float)));
+	glVertexAttribDivisor(4, 1);
+}
+} // namespace
+
+SpriteBatch::SpriteBatch() : mDrawCalls(0), mBuffer(nullptr), mMesh(nullptr) {
+	constexpr const static float vertices[] = {
+		0.0f, 0.0f, // TL
+		0.0f, 1.0f, // BR
+		1.0f, 0.0f, // TR
+		1.0f, 1.0f, // BL
+	};
+
+	const static GLuint indices[] = {2, 1, 0,  // a
+					 1, 2, 3}; // b
+
+	// A couple hundred dropped items
+	mBuffer = std::make_unique<StreamBuffer>(256 * sizeof(Instance));
+	mMesh.reset(new Mesh(vertices, {}, {}, indices, {}));
+}
+
+SpriteBatch::~SpriteBatch() {}
+
+void SpriteBatch::add(const Texture* const texture, const int layer, const Eigen::Vector2f& position,
+		      const Eigen::Vector2f& size, const Eigen::Vector4f& uv) {
+	mSprites.emplace_back(texture, layer,
+			      Instance{position.x(), position.y(), size.x(), size.y(), uv.x(), uv.y(), uv.z(), uv.w()});
+}
+
+void SpriteBatch::draw() {
+	mDrawCalls = 0;
+	if (mSprites.empty()) {
+		return;
+	}
+
+	// Stable so sprites of a texture keep their order
+	std::ranges::stable_sort(mSprites, [](const Sprite& a, const Sprite& b) {
+		if (a.mLayer != b.mLayer) {
+			return a.mLayer < b.mLayer;
+		}
+
+		return std::less<const Texture*>()(a.mTexture, b.mTexture);
+	});
+
+	mInstances.clear();
+	for (const Sprite& sprite : mSprites) {
+		mInstances.emplace_back(sprite.mInstance);
+	}
+
+	mBuffer->upload(mInstances.data(), mInstances.size() * sizeof(Instance));
+
+	// A draw for every run of sprites with the same texture and layer
+	for (std::size_t first = 0; first < mSprites.size();) {
+		std::size_t last = first + 1;
+		while (last < mSprites.size() && mSprites[last].mTexture == mSprites[first].mTexture &&
+		       mSprites[last].mLayer == mSprites[first].mLayer) {
+			++last;
+		}
+
+		mSprites[first].mTexture->activate(0);
+		const GLintptr offset = mBuffer->getOffset() + first * sizeof(Instance);
+		mMesh->bindAttribArray(mBuffer->getBuffer(), offset, bindInstances);
+		mMesh->drawInstanced(last - first);
+		++mDrawCalls;
+
+		first = last;
+	}
+
+	mSprites.clear();
+}
@@ -0,0 +1,105 @@
+#include "opengl/streamBuffer.hpp"
+
+#include "third_party/glad/glad.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+StreamBuffer::StreamBuffer(const GLsizeiptr capacity)
+	: mBuffer(0), mCapacity(std::max<GLsizeiptr>(capacity, 1)), mRegion(0), mOffset(0), mFences{} {
+	glGenBuffers(1, &mBuffer);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+	glBufferData(GL_ARRAY_BUFFER, mCapacity * REGIONS, nullptr, GL_STREAM_DRAW);
+}
+
+StreamBuffer::~StreamBuffer() {
+	for (const GLsync fence : mFences) {
+		if (fence != nullptr) {
+			glDeleteSync(fence);
+		}
+	}
+
+	glDeleteBuffers(1, &mBuffer);
+}
+
+/*
+ * Every draw reading a region is issued before the next upload, so a fence put down at the start of the next upload
+ * tells when the region is free again. With three regions the GPU can be two frames behind before we wait on it
+ *
+ * Persistent mapping needs glBufferStorage from 4.4, we ask for 4.1 so the regions are mapped unsynchronized instead
+ */
+bool StreamBuffer::upload(const void* const data, const GLsizeiptr size) {
+	const auto* const bytes = static_cast<const std::byte*>(data);
+	if (mLast.size() == static_cast<std::size_t>(size) && std::equal(mLast.begin(), mLast.end(), bytes)) {
+		return false;
+	}
+
+	mLast.assign(bytes, bytes + size);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+
+#ifdef __EMSCRIPTEN__
+	// No mapping on WebGL, orphan the storage and let the browser deal with it
+	if (size > mCapacity) {
+		mCapacity = std::max(size, mCapacity * 2);
+	}
+
+	glBufferData(GL_ARRAY_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+	mOffset = 0;
+#else
+	if (size > mCapacity) {
+		grow(size);
+	} else {
+		mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		mRegion = (mRegion + 1) % REGIONS;
+	}
+
+	if (GLsync& fence = mFences[mRegion]; fence != nullptr) {
+		// Only waits when the GPU is more than two frames behind
+		if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+			glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	mOffset = mCapacity * mRegion;
+
+	constexpr const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+	void* const region = glMapBufferRange(GL_ARRAY_BUFFER, mOffset, size, access);
+	if (region != nullptr) {
+		std::memcpy(region, data, size);
+
+		if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) {
+			// The storage got lost (mode switch...), the copy has to go through the driver
+			glBufferSubData(GL_ARRAY_BUFFER, mOffset, size, data);
+		}
+	} else {
+		SDL_Log("\033[33mStreamBuffer.cpp: Failed to map region, copying\033[0m");
+
+		glBufferSubData(GL_ARRAY_BUFFER, mOffset, size, data);
+	}
+#endif
+
+	return true;
+}
+
+void StreamBuffer::grow(const GLsizeiptr size) {
+	mCapacity = std::max(size, mCapacity * 2);
+
+	// The new storage isn't used by anything
+	for (GLsync& fence : mFences) {
+		if (fence != nullptr) {
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	mRegion = 0;
+	glBufferData(GL_ARRAY_BUFFER, mCapacity * REGIONS, nullptr, GL_STREAM_DRAW);
+}
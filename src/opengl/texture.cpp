@@ -1,5 +1,6 @@
 #include "opengl/texture.hpp"
 
+#include "opengl/glState.hpp"
 #include "third_party/glad/glad.h"
 #include "third_party/stb_image.h"
 #include "utils.hpp"
@@ -17,7 +18,7 @@ Texture::Texture(const Eigen::Vector2i& size, unsigned char* bitmap)
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
 	glGenTextures(1, &mID);
-	glBindTexture(GL_TEXTURE_2D, mID);
+	GLState::bindTexture(0, mID);
 
 	// See https://developer.mozilla.org/en-US/docs/Web/API/WebGLRenderingContext/texImage2D
 	glTexImage2D(GL_TEXTURE_2D, 0,
@@ -36,7 +37,7 @@ Texture::Texture(const Eigen::Vector2i& size, unsigned char* bitmap)
 
 Texture::Texture(const Eigen::Vector2i& size) {
 	glGenTextures(1, &mID);
-	glBindTexture(GL_TEXTURE_2D, mID);
+	GLState::bindTexture(0, mID);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x(), size.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -47,13 +48,13 @@ Texture::Texture(const Eigen::Vector2i& size) {
 
 Texture::~Texture() {
 	glDeleteTextures(1, &mID);
+	GLState::invalidate();
 
 	SDL_Log("Unloading texture %s", name.data());
 }
 
 void Texture::activate(const unsigned int num) const {
-	glActiveTexture(GL_TEXTURE0 + num);
-	glBindTexture(GL_TEXTURE_2D, mID);
+	GLState::bindTexture(num, mID);
 }
 
 // NOTE: Maybe load on demand?
@@ -117,7 +118,7 @@ bool Texture::load(bool srgb) {
 	}
 
 	glGenTextures(1, &mID);
-	glBindTexture(GL_TEXTURE_2D, mID);
+	GLState::bindTexture(0, mID);
 
 	SDL_assert(mWidth > 0 && mHeight > 0);
 	glTexImage2D(GL_TEXTURE_2D, 0, srgb ? intFormat : format, mWidth, mHeight, 0, format, GL_UNSIGNED_BYTE,
@@ -19,6 +19,12 @@ void UBO::set(const GLintptr offset, const Eigen::Affine3f& matrix) const {
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
+void UBO::set(const GLintptr offset, const GLsizeiptr size, const void* const data) const {
+	glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 void UBO::bind(const GLuint index) const {
 	glBindBufferRange(GL_UNIFORM_BUFFER, index, mUBO, 0, mSize);
 }
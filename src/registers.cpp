@@ -4,13 +4,20 @@
 #include "components/crafting.hpp"
 #include "components/furnace.hpp"
 #include "items.hpp"
+#include "scenes/blockTicker.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/level.hpp"
 #include "screens/screen.hpp"
 #include "third_party/Eigen/Core"
 
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace registers {
 
@@ -33,6 +40,8 @@ std::unordered_map<Components::Item, std::string> TEXTURES = {
 	{Item::OAK_PLANKS, "blocks/oak-planks.png"},
 	{Item::STONE, "blocks/stone.png"},
 	{Item::TORCH, "blocks/torch.png"},
+	{Item::WATER, "blocks/water.png"},
+	{Item::LAVA, "blocks/lava.png"},
 
 	{Item::APPLE, "items/apple.png"},
 	{Item::COAL, "items/coal.png"},
@@ -414,6 +423,83 @@ constexpr const static inline auto BLOCK_SIZE = 16 * 7;
 const std::unordered_map<Components::Item, std::pair<Eigen::Vector2f, Eigen::Vector2f>> COLLISION_BOXES = {
 	{Item::CAMPFIRE, {Eigen::Vector2f(0, 0), Eigen::Vector2f(BLOCK_SIZE, BLOCK_SIZE / 2)}},
 	{Item::TORCH, {Eigen::Vector2f(0, 0), Eigen::Vector2f(0, 0)}},
+	{Item::WATER, {Eigen::Vector2f(0, 0), Eigen::Vector2f(0, 0)}},
+	{Item::LAVA, {Eigen::Vector2f(0, 0), Eigen::Vector2f(0, 0)}},
+};
+
+const std::unordered_map<Components::Item, std::uint8_t> LIGHT_LEVELS = {
+	{Item::TORCH, 14},
+	{Item::CAMPFIRE, 15},
+	{Item::LAVA, 15},
+};
+
+const std::unordered_map<Components::Item,
+			 std::pair<std::uint64_t, std::uint64_t (*)(Level*, const Eigen::Vector2i&)>>
+	SCHEDULED_TICKS = {
+		{Item::FURNACE,
+		 {1,
+		  [](Level* level, const Eigen::Vector2i&) -> std::uint64_t {
+			  static_cast<FurnaceInventory*>(CLICKABLES.at(Item::FURNACE)())
+				  ->tick(level->getScene(), level->getTicker()->getTick());
+
+			  return 1;
+		  }}},
+		// Scheduled when a log nearby is broken
+		{Item::OAK_LEAVES,
+		 {0,
+		  [](Level* level, const Eigen::Vector2i& pos) -> std::uint64_t {
+			  // Look for a log through the leaves
+			  std::vector<Eigen::Vector2i> leaves = {pos};
+			  for (std::size_t i = 0; i < leaves.size(); ++i) {
+				  for (const auto& direction : {Eigen::Vector2i(1, 0), Eigen::Vector2i(-1, 0),
+								Eigen::Vector2i(0, 1), Eigen::Vector2i(0, -1)}) {
+					  const Eigen::Vector2i next = leaves[i] + direction;
+					  if ((next - pos).cwiseAbs().sum() > BlockTicker::DECAY_RANGE ||
+					      std::ranges::find(leaves, next) != leaves.end()) {
+						  continue;
+					  }
+
+					  const Item type = level->getTile(next);
+					  if (type == Item::OAK_LOG) {
+						  return 0;
+					  }
+
+					  if (type == Item::OAK_LEAVES) {
+						  leaves.emplace_back(next);
+					  }
+				  }
+			  }
+
+			  // Decayed leaves don't drop anything for now
+			  level->setBlock(pos, AIR());
+
+			  return 0;
+		  }}},
+};
+
+const std::unordered_map<Components::Item, void (*)(Level*, const Eigen::Vector2i&)> RANDOM_TICKS = {
+	{Item::GRASS_BLOCK,
+	 [](Level* level, const Eigen::Vector2i& pos) {
+		 const Eigen::Vector2i up(0, 1);
+
+		 // Covered grass dies
+		 if (Chunk::isSolid(level->getTile(pos + up))) {
+			 level->setBlock(pos, Item::DIRT);
+
+			 return;
+		 }
+
+		 if (level->getLight(pos + up) < 9) {
+			 return;
+		 }
+
+		 // Spread to some dirt around that can see the light
+		 const Eigen::Vector2i target = pos + Eigen::Vector2i(SDL_rand(3) - 1, SDL_rand(5) - 3);
+		 if (level->getTile(target) == Item::DIRT && !Chunk::isSolid(level->getTile(target + up)) &&
+		     level->getLight(target + up) >= 4) {
+			 level->setBlock(target, Item::GRASS_BLOCK);
+		 }
+	 }},
 };
 
 const std::vector<std::tuple<float, std::uint64_t, Components::Item, std::uint64_t>> VEINS = {
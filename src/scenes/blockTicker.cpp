@@ -0,0 +1,243 @@
+#include "scenes/blockTicker.hpp"
+
+#include "components.hpp"
+#include "items.hpp"
+#include "registers.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/level.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/rapidjson/document.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+BlockTicker::BlockTicker(Level* level) : mLevel(level), mTick(0) {}
+
+void BlockTicker::addChunk(const std::int64_t position) {
+	SDL_assert(std::ranges::find(mLoaded, position) == mLoaded.end());
+
+	mLoaded.emplace_back(position);
+
+	auto parked = mParked.extract(position);
+	if (parked.empty()) {
+		// Never seen, nothing to catch up on
+		mPending[position] = Parked{mTick, {}, true};
+	} else {
+		mPending[position] = std::move(parked.mapped());
+	}
+}
+
+void BlockTicker::removeChunk(const std::int64_t position) {
+	std::erase(mLoaded, position);
+
+	// Didn't even get a tick
+	if (auto pending = mPending.extract(position); !pending.empty()) {
+		mParked.insert(std::move(pending));
+
+		return;
+	}
+
+	Parked& parked = mParked[position];
+	parked.mUnloaded = mTick;
+	parked.mScan = false;
+	parked.mEvents.clear();
+
+	const auto inChunk = [position](const Event& event) { return Chunk::getChunk(event.mPos.x()) == position; };
+	const auto park = [&parked, &inChunk](std::vector<Event>& events) {
+		for (const Event& event : events) {
+			if (inChunk(event)) {
+				parked.mEvents.emplace_back(event);
+			}
+		}
+
+		std::erase_if(events, inChunk);
+	};
+
+	for (auto& slot : mWheel) {
+		park(slot);
+	}
+	park(mLater);
+}
+
+void BlockTicker::clear() {
+	mTick = 0;
+
+	for (auto& slot : mWheel) {
+		slot.clear();
+	}
+	mLater.clear();
+	mLoaded.clear();
+	mPending.clear();
+	mParked.clear();
+}
+
+void BlockTicker::load(const rapidjson::Value& data) {
+	clear();
+
+	if (!data.IsObject() || !data.HasMember(TICK_KEY)) {
+		return;
+	}
+
+	mTick = data[TICK_KEY].GetUint64();
+
+	for (const auto& chunk : data[PARKED_KEY].GetArray()) {
+		mParked[chunk[0].GetInt64()] = Parked{chunk[1].GetUint64(), {}, true};
+	}
+}
+
+void BlockTicker::save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& allocator) const {
+	data.SetObject();
+	data.AddMember(rapidjson::StringRef(TICK_KEY), mTick, allocator);
+
+	rapidjson::Value parked(rapidjson::kArrayType);
+	for (const auto& [position, chunk] : mParked) {
+		rapidjson::Value entry(rapidjson::kArrayType);
+		entry.PushBack(position, allocator);
+		entry.PushBack(chunk.mUnloaded, allocator);
+
+		parked.PushBack(entry.Move(), allocator);
+	}
+
+	data.AddMember(rapidjson::StringRef(PARKED_KEY), parked.Move(), allocator);
+}
+
+void BlockTicker::schedule(const Eigen::Vector2i& pos, const Components::Item type, const std::uint64_t delay) {
+	SDL_assert(registers::SCHEDULED_TICKS.contains(type));
+
+	// The current slot is already being walked
+	insert(Event{pos, type, mTick + std::max<std::uint64_t>(delay, 1)});
+}
+
+void BlockTicker::blockChanged(const Eigen::Vector2i& pos, const Components::Item from, const Components::Item to) {
+	if (const auto ticks = registers::SCHEDULED_TICKS.find(to);
+	    ticks != registers::SCHEDULED_TICKS.end() && ticks->second.first != 0) {
+		schedule(pos, to, ticks->second.first);
+	}
+
+	// Leaf decay is a bit random, so trees don't vanish all at once
+	if (from == Components::Item::OAK_LOG) {
+		for (int x = -DECAY_RANGE; x <= DECAY_RANGE; ++x) {
+			for (int y = -DECAY_RANGE; y <= DECAY_RANGE; ++y) {
+				const Eigen::Vector2i leaf = pos + Eigen::Vector2i(x, y);
+
+				if (mLevel->getTile(leaf) == Components::Item::OAK_LEAVES) {
+					schedule(leaf, Components::Item::OAK_LEAVES, 20 + SDL_rand(40));
+				}
+			}
+		}
+	}
+}
+
+void BlockTicker::tick() {
+	++mTick;
+
+	// Chunks loaded since the last tick
+	for (auto& [position, parked] : mPending) {
+		catchUp(position, parked);
+	}
+	mPending.clear();
+
+	// The wheel came around, pull in what is now close enough
+	if (mTick % WHEEL_SIZE == 0) {
+		std::erase_if(mLater, [this](const Event& event) {
+			if (event.mDue - mTick >= WHEEL_SIZE) {
+				return false;
+			}
+
+			mWheel[event.mDue % WHEEL_SIZE].emplace_back(event);
+
+			return true;
+		});
+	}
+
+	std::swap(mDue, mWheel[mTick % WHEEL_SIZE]);
+	for (const Event& event : mDue) {
+		SDL_assert(event.mDue == mTick);
+
+		// Broken or replaced since
+		if (mLevel->getTile(event.mPos) != event.mType) {
+			continue;
+		}
+
+		if (const std::uint64_t delay = registers::SCHEDULED_TICKS.at(event.mType).second(mLevel, event.mPos);
+		    delay != 0) {
+			schedule(event.mPos, event.mType, delay);
+		}
+	}
+	mDue.clear();
+
+	for (const std::int64_t position : mLoaded) {
+		for (int section = 0; section < Chunk::MAX_HEIGHT / SECTION_HEIGHT; ++section) {
+			for (int i = 0; i < RANDOM_TICK_SPEED; ++i) {
+				randomTick(Eigen::Vector2i(position * Chunk::CHUNK_WIDTH + SDL_rand(Chunk::CHUNK_WIDTH),
+							   section * SECTION_HEIGHT + SDL_rand(SECTION_HEIGHT)));
+			}
+		}
+	}
+}
+
+void BlockTicker::insert(const Event& event) {
+	SDL_assert(event.mDue >= mTick);
+
+	if (event.mDue - mTick >= WHEEL_SIZE) {
+		mLater.emplace_back(event);
+	} else {
+		mWheel[event.mDue % WHEEL_SIZE].emplace_back(event);
+	}
+}
+
+void BlockTicker::catchUp(const std::int64_t position, Parked& parked) {
+	// Whatever came due while away runs this tick
+	for (Event& event : parked.mEvents) {
+		event.mDue = std::max(event.mDue, mTick);
+
+		insert(event);
+	}
+
+	// Random ticks hitting a block are a poisson process, roll how many it missed instead of replaying them
+	const double expected = static_cast<double>(mTick - parked.mUnloaded) * RANDOM_TICK_SPEED /
+				(Chunk::CHUNK_WIDTH * SECTION_HEIGHT);
+	const double limit = SDL_exp(-expected);
+
+	if (expected == 0 && !parked.mScan) {
+		return;
+	}
+
+	for (int x = 0; x < Chunk::CHUNK_WIDTH; ++x) {
+		for (int y = 0; y < Chunk::MAX_HEIGHT; ++y) {
+			const Eigen::Vector2i pos(position * Chunk::CHUNK_WIDTH + x, y);
+			const Components::Item type = mLevel->getTile(pos);
+
+			if (parked.mScan) {
+				if (const auto ticks = registers::SCHEDULED_TICKS.find(type);
+				    ticks != registers::SCHEDULED_TICKS.end() && ticks->second.first != 0) {
+					schedule(pos, type, ticks->second.first);
+				}
+			}
+
+			if (expected == 0 || !registers::RANDOM_TICKS.contains(type)) {
+				continue;
+			}
+
+			std::uint64_t hits = 0;
+			for (double p = SDL_randf(); p > limit && hits < MAX_CATCH_UP; p *= SDL_randf()) {
+				++hits;
+			}
+
+			for (std::uint64_t i = 0; i < hits; ++i) {
+				randomTick(pos);
+			}
+		}
+	}
+}
+
+void BlockTicker::randomTick(const Eigen::Vector2i& pos) {
+	const auto tick = registers::RANDOM_TICKS.find(mLevel->getTile(pos));
+	if (tick == registers::RANDOM_TICKS.end()) {
+		return;
+	}
+
+	tick->second(mLevel, pos);
+}
@@ -15,27 +15,29 @@
 #include "third_party/rapidjson/rapidjson.h"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <unordered_map>
 
-Chunk::Chunk(Scene* scene, NoiseGenerator* const noise, const std::int64_t position) : mPosition(position) {
+Chunk::Tiles Chunk::generate(NoiseGenerator* const noise, const std::int64_t position) {
 	// We shall first generate a chunk map
-	// Then we shall spawn the blocks
-
-	// Indexed by x and then y
-	std::vector<std::vector<Components::Item>> grid(CHUNK_WIDTH, std::vector(WATER_LEVEL * 2, Components::AIR()));
+	// The blocks get spawned by the caller
+	noise->seedChunk(position);
+	Tiles tiles;
+	tiles.mGrid.assign(CHUNK_WIDTH, std::vector(WATER_LEVEL * 2, Components::AIR()));
 
 	// Spawn blocks
-	const auto offset = mPosition * CHUNK_WIDTH;
+	const auto offset = position * CHUNK_WIDTH;
 	for (std::uint64_t i = 0; i < CHUNK_WIDTH; ++i) {
 		const double height = noise->getNoise(i + position * CHUNK_WIDTH);
 		const std::uint64_t block_height = WATER_LEVEL + 5 * height;
-		mHeightMap[i] = block_height;
 
 		for (std::uint64_t y = 0; y < block_height; ++y) {
-			grid[i][y] = Components::Item::STONE;
+			tiles.mGrid[i][y] = Components::Item::STONE;
 		}
-		grid[i][block_height] = Components::Item::GRASS_BLOCK;
+		tiles.mGrid[i][block_height] = Components::Item::GRASS_BLOCK;
 
 		// Spawn structures
 		for (const auto& [chance, structure] : registers::SURFACE_STRUCTURES) {
@@ -47,78 +49,145 @@ Chunk::Chunk(Scene* scene, NoiseGenerator* const noise, const std::int64_t posit
 			}
 
 			if (roll < chance) {
-				spawnStructure(grid, Eigen::Vector2i(i, block_height), structure, scene);
+				spawnStructure(tiles, Eigen::Vector2i(i, block_height), position, structure);
 			}
 		}
 	}
 
-	carve(grid, noise);
-	spawnOres(grid, noise);
+	carve(tiles.mGrid, noise);
+	spawnOres(tiles.mGrid, noise);
+
+	for (std::uint64_t x = 0; x < CHUNK_WIDTH; ++x) {
+		tiles.mHeightMap[x] = NO_SURFACE;
+
+		for (std::int64_t y = WATER_LEVEL * 2 - 1; y >= 0; --y) {
+			if (isSolid(tiles.mGrid[x][y])) {
+				tiles.mHeightMap[x] = y;
+
+				break;
+			}
+		}
+
+		// Lakes in the columns under the water level
+		if constexpr (LAKES) {
+			for (std::int64_t y = std::max<std::int64_t>(tiles.mHeightMap[x] + 1, 0); y < WATER_LEVEL; ++y) {
+				if (tiles.mGrid[x][y] == Components::AIR()) {
+					tiles.mGrid[x][y] = Components::Item::WATER;
+				}
+			}
+		}
+	}
+
+	return tiles;
+}
+
+Chunk::Chunk(Scene* scene, NoiseGenerator* const noise, const std::int64_t position) : mPosition(position) {
+	Tiles tiles = generate(noise, position);
+	mHeightMap = tiles.mHeightMap;
+	mTiles.fill(Components::AIR());
+	mEntities.fill(MAX_ENTITIES);
+
+	const auto offset = mPosition * CHUNK_WIDTH;
+	const auto key = [](const Eigen::Vector2i& pos) {
+		return static_cast<std::uint64_t>(pos.x()) << 32 | static_cast<std::uint32_t>(pos.y());
+	};
+
+	// Blocks already in this chunk and its neighbours, a single pass over the scene
+	// The loaded neighbours' structures might reach in here, and ours into them
+	std::unordered_map<std::uint64_t, Components::Item> occupied;
+	std::vector<std::pair<Components::Item, Eigen::Vector2i>> placed;
+	for (const auto& [entity, block] : scene->view<Components::block>().each()) {
+		const std::int64_t chunk = getChunk(block.mPosition.x());
+		if (chunk < mPosition - 1 || chunk > mPosition + 1) {
+			continue;
+		}
+
+		occupied.emplace(key(block.mPosition), block.mType);
+		if (chunk == mPosition) {
+			placed.emplace_back(block.mType, block.mPosition);
+			setEntity(block.mPosition, entity);
+		}
+	}
+
+	// Structures of this chunk reaching into the neighbours
+	for (const auto& [type, pos] : tiles.mOverflow) {
+		if (occupied.contains(key(pos))) {
+			continue;
+		}
+
+		spawnBlock(scene, type, pos);
+		mOverflow.emplace_back(type, pos);
+	}
 
 	// Finally spawn the blocks
-	const auto& blockView = scene->view<Components::block>();
 	for (std::uint64_t x = 0; x < CHUNK_WIDTH; ++x) {
 		for (std::uint64_t y = 0; y < WATER_LEVEL * 2; ++y) {
-			if (grid[x][y] == Components::AIR()) {
+			if (tiles.mGrid[x][y] == Components::AIR()) {
 				continue;
 			}
 
-			const Eigen::Vector2i pos = Eigen::Vector2i(x + mPosition * CHUNK_WIDTH, y);
+			const Eigen::Vector2i pos = Eigen::Vector2i(x + offset, y);
 
-			Components::Item occupied = Components::AIR();
-			for (const auto block : blockView) {
-				if (scene->get<Components::block>(block).mPosition == pos) {
-					occupied = scene->get<Components::block>(block).mType;
-					break;
-				}
+			// Neighbours might have already placed a structure here
+			if (occupied.contains(key(pos))) {
+				continue;
 			}
 
-			if (occupied != Components::AIR()) {
-				grid[x][y] = occupied;
+			setEntity(pos, spawnBlock(scene, tiles.mGrid[x][y], pos));
+			setTile(pos, tiles.mGrid[x][y]);
+		}
+	}
 
-				continue;
-			}
+	// Whatever the neighbours placed goes in the tiles and the heightmap, air tiles included
+	for (const auto& [type, pos] : placed) {
+		blockPlaced(pos, type);
+	}
+}
 
-			Texture* const texture =
-				Game::getInstance()->getSystemManager()->getTexture(registers::TEXTURES.at(grid[x][y]));
-			const EntityID entity = scene->newEntity();
-			scene->emplace<Components::block>(entity, grid[x][y], Eigen::Vector2i(x + offset, y));
-			scene->emplace<Components::texture>(entity, texture);
-
-			if (registers::COLLISION_BOXES.contains(grid[x][y])) {
-				const auto& collision = registers::COLLISION_BOXES.at(grid[x][y]);
-				scene->emplace<Components::collision>(entity, collision.first, collision.second, true);
-			} else {
-				scene->emplace<Components::collision>(entity, Eigen::Vector2f(0.0f, 0.0f),
-								      texture->getSize(), true);
+namespace {
+// Calls func with the type and world position of every non-air tile
+template <typename Func> void unpack(const Chunk::Packed& data, Func func) {
+	std::uint64_t index = 0;
+	for (const auto run : data.mRuns) {
+		const Components::Item type = data.mPalette[run & 0xFF];
+		const std::uint64_t length = run >> 8;
+
+		if (type != Components::AIR()) {
+			for (std::uint64_t i = index; i < index + length; ++i) {
+				func(type, Eigen::Vector2i(i / data.mHeight + data.mPosition * Chunk::CHUNK_WIDTH,
+							   i % data.mHeight + data.mBottom));
 			}
 		}
+
+		index += length;
 	}
 }
+} // namespace
 
 // Loading from save
 Chunk::Chunk(const rapidjson::Value& data, Scene* scene) : mPosition(data[POSITION_KEY].GetInt64()) {
+	// Older saves don't have the heightmap, build it while loading
+	const bool savedHeightMap = data.HasMember(HEIGHTMAP_KEY) && data[HEIGHTMAP_KEY].Size() == CHUNK_WIDTH;
+	mHeightMap.fill(NO_SURFACE);
+	mTiles.fill(Components::AIR());
+	mEntities.fill(MAX_ENTITIES);
+
 	for (rapidjson::SizeType i = 0; i < data[BLOCKS_KEY].Size(); i++) {
 		const Components::Item block = static_cast<Components::Item>(data[BLOCKS_KEY][i][0].GetUint64());
+		const Eigen::Vector2i pos = getVector2i(data[BLOCKS_KEY][i][1]);
 
-		SDL_assert(registers::TEXTURES.contains(block));
-
-		Texture* const texture =
-			Game::getInstance()->getSystemManager()->getTexture(registers::TEXTURES.at(block));
-
-		const EntityID entity = scene->newEntity();
-		scene->emplace<Components::block>(entity, block, getVector2i(data[BLOCKS_KEY][i][1]));
-		scene->emplace<Components::texture>(entity, texture);
+		setEntity(pos, spawnBlock(scene, block, pos));
 
-		if (registers::COLLISION_BOXES.contains(block)) {
-			const auto& box = registers::COLLISION_BOXES.at(block);
-
-			if (!(box.second.x() == 0 || box.second.y() == 0)) {
-				scene->emplace<Components::collision>(entity, box.first, box.second, true);
-			}
+		if (savedHeightMap) {
+			setTile(pos, block);
 		} else {
-			scene->emplace<Components::collision>(entity, Eigen::Vector2f(0.0f, 0.0f), texture->getSize(),
-							      true);
+			blockPlaced(pos, block);
+		}
+	}
+
+	if (savedHeightMap) {
+		for (rapidjson::SizeType i = 0; i < CHUNK_WIDTH; i++) {
+			mHeightMap[i] = data[HEIGHTMAP_KEY][i].GetInt64();
 		}
 	}
 }
@@ -126,6 +195,11 @@ Chunk::Chunk(const rapidjson::Value& data, Scene* scene) : mPosition(data[POSITI
 void Chunk::save(class Scene* scene, rapidjson::Value& chunk, rapidjson::MemoryPoolAllocator<>& allocator) {
 	chunk.AddMember(rapidjson::StringRef(POSITION_KEY), rapidjson::Value(mPosition).Move(), allocator);
 	chunk.AddMember(rapidjson::StringRef(BLOCKS_KEY), rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+	chunk.AddMember(rapidjson::StringRef(HEIGHTMAP_KEY), rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+
+	for (const auto height : mHeightMap) {
+		chunk[HEIGHTMAP_KEY].PushBack(height, allocator);
+	}
 
 	/*
 	for (const auto item : scene->view<Components::item>()) {
@@ -148,8 +222,7 @@ void Chunk::save(class Scene* scene, rapidjson::Value& chunk, rapidjson::MemoryP
 
 	for (const auto block : scene->view<Components::block>()) {
 		// Not in the chunk
-		if ((scene->get<Components::block>(block).mPosition.x() / CHUNK_WIDTH -
-		     (scene->get<Components::block>(block).mPosition.x() < 0)) != mPosition) {
+		if (getChunk(scene->get<Components::block>(block).mPosition.x()) != mPosition) {
 			continue;
 		}
 
@@ -166,53 +239,228 @@ void Chunk::save(class Scene* scene, rapidjson::Value& chunk, rapidjson::MemoryP
 	}
 }
 
-void Chunk::spawnStructure(std::vector<std::vector<Components::Item>>& blocks, const Eigen::Vector2i& pos,
-			   const std::vector<std::pair<Components::Item, Eigen::Vector2i>> structure,
-			   Scene* const scene) {
-	const auto& blockView = scene->view<Components::block>();
-	for (const auto& [blockType, offset] : structure) {
-		const Eigen::Vector2i realPos = pos + offset;
+// Loading from the cache
+Chunk::Chunk(const Packed& data, Scene* scene) : mPosition(data.mPosition), mHeightMap(data.mHeightMap) {
+	mTiles.fill(Components::AIR());
+	mEntities.fill(MAX_ENTITIES);
 
-		if (realPos.x() < 0 || realPos.x() >= CHUNK_WIDTH) {
-			// Lets place in scene
-			const Eigen::Vector2i position = offset + pos + Eigen::Vector2i(mPosition * CHUNK_WIDTH, 0);
+	unpack(data, [this, scene](const Components::Item type, const Eigen::Vector2i& position) {
+		setEntity(position, spawnBlock(scene, type, position));
+		setTile(position, type);
+	});
+}
 
-			bool occupied = false;
-			for (const auto block : blockView) {
-				if (scene->get<Components::block>(block).mPosition == position) {
-					occupied = true;
-					break;
-				}
-			}
+void Chunk::save(Scene* scene, Packed& chunk) {
+	std::vector<std::pair<Components::Item, Eigen::Vector2i>> blocks;
+	std::int64_t bottom = std::numeric_limits<std::int64_t>::max();
+	std::int64_t top = std::numeric_limits<std::int64_t>::min();
 
-			if (occupied) {
-				continue;
+	for (const auto block : scene->view<Components::block>()) {
+		const auto& component = scene->get<Components::block>(block);
+
+		// Not in the chunk
+		if (getChunk(component.mPosition.x()) != mPosition) {
+			continue;
+		}
+
+		blocks.emplace_back(component.mType, component.mPosition);
+		bottom = std::min<std::int64_t>(bottom, component.mPosition.y());
+		top = std::max<std::int64_t>(top, component.mPosition.y());
+
+		scene->erase(block);
+	}
+
+	chunk.mPosition = mPosition;
+	chunk.mHeightMap = mHeightMap;
+	chunk.mPalette.clear();
+	chunk.mRuns.clear();
+
+	if (blocks.empty()) {
+		chunk.mBottom = 0;
+		chunk.mHeight = 0;
+
+		return;
+	}
+
+	chunk.mBottom = bottom;
+	chunk.mHeight = top - bottom + 1;
+
+	// Columns are stored one after another, so the stone stays in long runs
+	std::vector<Components::Item> tiles(CHUNK_WIDTH * chunk.mHeight, Components::AIR());
+	for (const auto& [type, position] : blocks) {
+		tiles[(position.x() - mPosition * CHUNK_WIDTH) * chunk.mHeight + (position.y() - bottom)] = type;
+	}
+
+	constexpr const std::uint32_t MAX_RUN = 0xFFFFFF;
+	for (const auto tile : tiles) {
+		std::uint32_t index = 0;
+		while (index < chunk.mPalette.size() && chunk.mPalette[index] != tile) {
+			++index;
+		}
+
+		if (index == chunk.mPalette.size()) {
+			SDL_assert(index <= 0xFF && "Too many block types for the palette");
+			chunk.mPalette.emplace_back(tile);
+		}
+
+		if (!chunk.mRuns.empty() && (chunk.mRuns.back() & 0xFF) == index && (chunk.mRuns.back() >> 8) < MAX_RUN) {
+			chunk.mRuns.back() += 1 << 8;
+		} else {
+			chunk.mRuns.emplace_back(1 << 8 | index);
+		}
+	}
+}
+
+void Chunk::save(const Packed& data, rapidjson::Value& chunk, rapidjson::MemoryPoolAllocator<>& allocator) {
+	chunk.AddMember(rapidjson::StringRef(POSITION_KEY), rapidjson::Value(data.mPosition).Move(), allocator);
+	chunk.AddMember(rapidjson::StringRef(BLOCKS_KEY), rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+	chunk.AddMember(rapidjson::StringRef(HEIGHTMAP_KEY), rapidjson::Value(rapidjson::kArrayType).Move(), allocator);
+
+	for (const auto height : data.mHeightMap) {
+		chunk[HEIGHTMAP_KEY].PushBack(height, allocator);
+	}
+
+	unpack(data, [&chunk, &allocator](const Components::Item type, const Eigen::Vector2i& position) {
+		rapidjson::Value i(rapidjson::kArrayType);
+
+		i.PushBack(etoi(type), allocator);
+		i.PushBack(fromVector2i(position, allocator).Move(), allocator);
+
+		chunk[BLOCKS_KEY].PushBack(i.Move(), allocator);
+	});
+}
+
+void Chunk::blockPlaced(const Eigen::Vector2i& pos, const Components::Item type) {
+	SDL_assert(getChunk(pos.x()) == mPosition);
+
+	setTile(pos, type);
+
+	auto& height = mHeightMap[pos.x() - mPosition * CHUNK_WIDTH];
+	if (isSolid(type) && pos.y() > height) {
+		height = pos.y();
+	}
+}
+
+void Chunk::blockBroken(Scene* scene, const Eigen::Vector2i& pos) {
+	SDL_assert(getChunk(pos.x()) == mPosition);
+
+	setTile(pos, Components::AIR());
+
+	auto& height = mHeightMap[pos.x() - mPosition * CHUNK_WIDTH];
+	if (pos.y() != height) {
+		return;
+	}
+
+	// The top got broken, look for the next one down
+	height = NO_SURFACE;
+	if (pos.y() < MAX_HEIGHT) {
+		for (std::int64_t y = pos.y() - 1; y >= 0; --y) {
+			if (isSolid(getTile(Eigen::Vector2i(pos.x(), y)))) {
+				height = y;
+
+				break;
 			}
+		}
 
+		return;
+	}
+
+	// Above the grid, we need to look at the scene
+	for (const auto& [entity, block] : scene->view<Components::block>().each()) {
+		if (block.mPosition.x() == pos.x() && block.mPosition.y() != pos.y() && isSolid(block.mType) &&
+		    block.mPosition.y() > height) {
+			height = block.mPosition.y();
+		}
+	}
+}
+
+Components::Item Chunk::getTile(const Eigen::Vector2i& pos) const {
+	if (pos.y() < 0 || pos.y() >= MAX_HEIGHT) {
+		return Components::AIR();
+	}
+
+	return mTiles[(pos.x() - mPosition * CHUNK_WIDTH) * MAX_HEIGHT + pos.y()];
+}
+
+EntityID Chunk::getEntity(const Eigen::Vector2i& pos) const {
+	if (pos.y() < 0 || pos.y() >= MAX_HEIGHT) {
+		return MAX_ENTITIES;
+	}
+
+	return mEntities[(pos.x() - mPosition * CHUNK_WIDTH) * MAX_HEIGHT + pos.y()];
+}
+
+void Chunk::setEntity(const Eigen::Vector2i& pos, const EntityID entity) {
+	if (pos.y() < 0 || pos.y() >= MAX_HEIGHT) {
+		return;
+	}
+
+	mEntities[(pos.x() - mPosition * CHUNK_WIDTH) * MAX_HEIGHT + pos.y()] = entity;
+}
+
+void Chunk::setTile(const Eigen::Vector2i& pos, const Components::Item type) {
+	if (pos.y() < 0 || pos.y() >= MAX_HEIGHT) {
+		return;
+	}
+
+	mTiles[(pos.x() - mPosition * CHUNK_WIDTH) * MAX_HEIGHT + pos.y()] = type;
+}
+
+bool Chunk::isSolid(const Components::Item type) {
+	if (type == Components::AIR()) {
+		return false;
+	}
+
+	if (!registers::COLLISION_BOXES.contains(type)) {
+		return true;
+	}
+
+	const auto& size = registers::COLLISION_BOXES.at(type).second;
+
+	return !(size.x() == 0 || size.y() == 0);
+}
+
+void Chunk::spawnStructure(Tiles& tiles, const Eigen::Vector2i& pos, const std::int64_t position,
+			   const std::vector<std::pair<Components::Item, Eigen::Vector2i>>& structure) {
+	for (const auto& [blockType, offset] : structure) {
+		const Eigen::Vector2i realPos = pos + offset;
+
+		if (realPos.x() < 0 || realPos.x() >= CHUNK_WIDTH) {
 			SDL_assert(registers::BREAK_TIMES.contains(blockType) &&
 				   "The block to be placed isn't brakable!");
 
-			Texture* const texture =
-				Game::getInstance()->getSystemManager()->getTexture(registers::TEXTURES.at(blockType));
-			const EntityID entity = scene->newEntity();
-			scene->emplace<Components::block>(entity, blockType, position);
-			scene->emplace<Components::texture>(entity, texture);
-
-			if (registers::COLLISION_BOXES.contains(blockType)) {
-				const auto& collision = registers::COLLISION_BOXES.at(blockType);
-				scene->emplace<Components::collision>(entity, collision.first, collision.second, true);
-			} else {
-				scene->emplace<Components::collision>(entity, Eigen::Vector2f(0.0f, 0.0f),
-								      texture->getSize(), true);
-			}
+			// Lets place in scene
+			tiles.mOverflow.emplace_back(blockType, realPos + Eigen::Vector2i(position * CHUNK_WIDTH, 0));
 		} else {
-			if (blocks[realPos.x()][realPos.y()] == Components::AIR()) {
-				blocks[realPos.x()][realPos.y()] = blockType;
+			if (tiles.mGrid[realPos.x()][realPos.y()] == Components::AIR()) {
+				tiles.mGrid[realPos.x()][realPos.y()] = blockType;
 			}
 		}
 	}
 }
 
+EntityID Chunk::spawnBlock(Scene* const scene, const Components::Item type, const Eigen::Vector2i& position) {
+	SDL_assert(registers::TEXTURES.contains(type));
+
+	Texture* const texture = Game::getInstance()->getSystemManager()->getTexture(registers::TEXTURES.at(type));
+
+	const EntityID entity = scene->newEntity();
+	scene->emplace<Components::block>(entity, type, position);
+	scene->emplace<Components::texture>(entity, texture);
+
+	if (registers::COLLISION_BOXES.contains(type)) {
+		const auto& box = registers::COLLISION_BOXES.at(type);
+
+		if (!(box.second.x() == 0 || box.second.y() == 0)) {
+			scene->emplace<Components::collision>(entity, box.first, box.second, true);
+		}
+	} else {
+		scene->emplace<Components::collision>(entity, Eigen::Vector2f(0.0f, 0.0f), texture->getSize(), true);
+	}
+
+	return entity;
+}
+
 void Chunk::carve(std::vector<std::vector<Components::Item>>& blocks, class NoiseGenerator* const noise) {
 	// TODO: Cave carver
 	(void)noise;
@@ -0,0 +1,71 @@
+#include "scenes/chunkCache.hpp"
+
+#include "scenes/chunk.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+ChunkCache::ChunkCache(const std::size_t maxSize) : mSize(0), mMaxSize(maxSize) {}
+
+std::vector<Chunk::Packed> ChunkCache::put(Chunk::Packed&& chunk) {
+	std::vector<Chunk::Packed> evicted;
+
+	// Replace a stale copy
+	if (mLookup.contains(chunk.mPosition)) {
+		const auto entry = mLookup[chunk.mPosition];
+
+		mSize -= entry->getSize();
+		mEntries.erase(entry);
+	}
+
+	mSize += chunk.getSize();
+	mEntries.emplace_front(std::move(chunk));
+	mLookup[mEntries.front().mPosition] = mEntries.begin();
+
+	// Always keep the newest one, even if it alone is over the limit
+	while (mSize > mMaxSize && mEntries.size() > 1) {
+		mSize -= mEntries.back().getSize();
+		mLookup.erase(mEntries.back().mPosition);
+
+		evicted.emplace_back(std::move(mEntries.back()));
+		mEntries.pop_back();
+	}
+
+	return evicted;
+}
+
+bool ChunkCache::take(const std::int64_t position, Chunk::Packed& chunk) {
+	const auto entry = mLookup.find(position);
+	if (entry == mLookup.end()) {
+		return false;
+	}
+
+	mSize -= entry->second->getSize();
+	chunk = std::move(*entry->second);
+
+	mEntries.erase(entry->second);
+	mLookup.erase(entry);
+
+	return true;
+}
+
+std::vector<Chunk::Packed> ChunkCache::flush() {
+	std::vector<Chunk::Packed> chunks;
+	chunks.reserve(mEntries.size());
+
+	for (auto& chunk : mEntries) {
+		chunks.emplace_back(std::move(chunk));
+	}
+
+	clear();
+
+	return chunks;
+}
+
+void ChunkCache::clear() {
+	mEntries.clear();
+	mLookup.clear();
+	mSize = 0;
+}
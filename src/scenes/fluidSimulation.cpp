@@ -0,0 +1,391 @@
+#include "scenes/fluidSimulation.hpp"
+
+#include "components.hpp"
+#include "items.hpp"
+#include "registers.hpp"
+#include "scenes/chunk.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/rapidjson/document.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace {
+const Eigen::Vector2i UP(0, 1);
+const Eigen::Vector2i DOWN(0, -1);
+const Eigen::Vector2i SIDES[] = {{-1, 0}, {1, 0}};
+const Eigen::Vector2i DIRECTIONS[] = {{-1, 0}, {1, 0}, UP, DOWN};
+
+constexpr const std::size_t WATER = 0;
+constexpr const std::size_t LAVA = 1;
+} // namespace
+
+// Water spreads 7 cells every 5 ticks, lava 3 cells every 30 ticks
+const std::array<FluidSimulation::Fluid, 2> FluidSimulation::FLUIDS = {
+	Fluid{Components::Item::WATER, 0x10, 5, 1},
+	Fluid{Components::Item::LAVA, 0x20, 30, 2},
+};
+
+FluidSimulation::FluidSimulation() : mLastSection(nullptr), mLastPosition(0) {}
+
+void FluidSimulation::addChunk(const std::int64_t position, const Chunk::Grid& tiles) {
+	SDL_assert(!mSections.contains(position));
+
+	Section& section = mSections[position];
+	section.mQueued.fill(0);
+
+	for (int i = 0; i < SIZE; ++i) {
+		section.mCells[i] = getCell(tiles[i]);
+	}
+
+	const std::int64_t offset = position * Chunk::CHUNK_WIDTH;
+
+	if (auto parked = mParked.extract(position); !parked.empty()) {
+		for (const auto& [index, cell] : parked.mapped().mFlowing) {
+			if ((section.mCells[index] & KIND) == (cell & KIND)) {
+				section.mCells[index] = cell;
+			}
+		}
+
+		for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+			for (const std::uint16_t index : parked.mapped().mActive[fluid]) {
+				queue(Eigen::Vector2i(offset + index / Chunk::MAX_HEIGHT, index % Chunk::MAX_HEIGHT), fluid);
+			}
+		}
+	}
+
+	// Let the fluid flow over the borders
+	for (const std::int64_t x : {offset - 1, offset, offset + Chunk::CHUNK_WIDTH - 1, offset + Chunk::CHUNK_WIDTH}) {
+		for (int y = 0; y < Chunk::MAX_HEIGHT; ++y) {
+			for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+				queue(Eigen::Vector2i(x, y), fluid);
+			}
+		}
+	}
+}
+
+void FluidSimulation::removeChunk(const std::int64_t position) {
+	const auto section = mSections.find(position);
+	if (section == mSections.end()) {
+		return;
+	}
+
+	Parked parked;
+	for (int i = 0; i < SIZE; ++i) {
+		const std::uint8_t cell = section->second.mCells[i];
+
+		if ((cell & KIND) != EMPTY && (cell & KIND) != SOLID && !(cell & SOURCE)) {
+			parked.mFlowing.emplace_back(i, cell);
+		}
+	}
+
+	const std::int64_t offset = position * Chunk::CHUNK_WIDTH;
+	for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+		std::erase_if(mActive[fluid], [&](const Eigen::Vector2i& pos) {
+			if (Chunk::getChunk(pos.x()) != position) {
+				return false;
+			}
+
+			parked.mActive[fluid].emplace_back((pos.x() - offset) * Chunk::MAX_HEIGHT + pos.y());
+
+			return true;
+		});
+	}
+
+	// Only sources left, the tiles say it all
+	if (!parked.mFlowing.empty() || !parked.mActive[WATER].empty() || !parked.mActive[LAVA].empty()) {
+		mParked[position] = std::move(parked);
+	}
+
+	mSections.erase(section);
+	mLastSection = nullptr;
+}
+
+void FluidSimulation::clear() {
+	mSections.clear();
+	mParked.clear();
+	mLastSection = nullptr;
+
+	for (auto& active : mActive) {
+		active.clear();
+	}
+	mChanges.clear();
+}
+
+void FluidSimulation::load(const rapidjson::Value& data) {
+	clear();
+
+	if (!data.IsArray()) {
+		return;
+	}
+
+	for (const auto& chunk : data.GetArray()) {
+		Parked& parked = mParked[chunk[POSITION_KEY].GetInt64()];
+
+		const auto& flowing = chunk[FLOWING_KEY].GetArray();
+		for (rapidjson::SizeType i = 0; i + 1 < flowing.Size(); i += 2) {
+			parked.mFlowing.emplace_back(flowing[i].GetUint(), flowing[i + 1].GetUint());
+		}
+
+		for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+			for (const auto& index : chunk[ACTIVE_KEY][fluid].GetArray()) {
+				parked.mActive[fluid].emplace_back(index.GetUint());
+			}
+		}
+	}
+}
+
+void FluidSimulation::save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& allocator) const {
+	data.SetArray();
+
+	for (const auto& [position, parked] : mParked) {
+		rapidjson::Value flowing(rapidjson::kArrayType);
+		for (const auto& [index, cell] : parked.mFlowing) {
+			flowing.PushBack(index, allocator);
+			flowing.PushBack(cell, allocator);
+		}
+
+		rapidjson::Value active(rapidjson::kArrayType);
+		for (const auto& cells : parked.mActive) {
+			rapidjson::Value indices(rapidjson::kArrayType);
+			for (const std::uint16_t index : cells) {
+				indices.PushBack(index, allocator);
+			}
+
+			active.PushBack(indices.Move(), allocator);
+		}
+
+		rapidjson::Value chunk(rapidjson::kObjectType);
+		chunk.AddMember(rapidjson::StringRef(POSITION_KEY), position, allocator);
+		chunk.AddMember(rapidjson::StringRef(FLOWING_KEY), flowing.Move(), allocator);
+		chunk.AddMember(rapidjson::StringRef(ACTIVE_KEY), active.Move(), allocator);
+
+		data.PushBack(chunk.Move(), allocator);
+	}
+}
+
+void FluidSimulation::setTile(const Eigen::Vector2i& pos, const Components::Item type) {
+	int index;
+	Section* const section = getSection(pos, index);
+	if (section == nullptr) {
+		return;
+	}
+
+	section->mCells[index] = getCell(type);
+
+	wake(pos);
+}
+
+void FluidSimulation::tick(const std::uint64_t tick) {
+	mChanges.clear();
+
+	for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+		if (tick % FLUIDS[fluid].mDelay == 0) {
+			step(fluid);
+		}
+	}
+}
+
+std::uint8_t FluidSimulation::getLevel(const Eigen::Vector2i& pos) const {
+	const std::uint8_t cell = getCell(pos);
+	if ((cell & KIND) == EMPTY || (cell & KIND) == SOLID) {
+		return 0;
+	}
+
+	return cell & LEVEL;
+}
+
+bool FluidSimulation::isFluid(const Components::Item type) {
+	return std::ranges::any_of(FLUIDS, [type](const Fluid& fluid) { return fluid.mItem == type; });
+}
+
+std::uint8_t FluidSimulation::getCell(const Components::Item type) {
+	if (type == Components::AIR()) {
+		return EMPTY;
+	}
+
+	for (const Fluid& fluid : FLUIDS) {
+		if (fluid.mItem == type) {
+			return fluid.mKind | SOURCE | MAX_LEVEL;
+		}
+	}
+
+	// Torches and the like stop fluids too
+	return SOLID;
+}
+
+Components::Item FluidSimulation::getItem(const std::uint8_t cell) {
+	for (const Fluid& fluid : FLUIDS) {
+		if (fluid.mKind == (cell & KIND)) {
+			return fluid.mItem;
+		}
+	}
+
+	return Components::AIR();
+}
+
+FluidSimulation::Section* FluidSimulation::getSection(const Eigen::Vector2i& pos, int& index) const {
+	if (pos.y() < 0 || pos.y() >= Chunk::MAX_HEIGHT) {
+		return nullptr;
+	}
+
+	const std::int64_t chunk = Chunk::getChunk(pos.x());
+	if (mLastSection == nullptr || mLastPosition != chunk) {
+		const auto section = mSections.find(chunk);
+		if (section == mSections.end()) {
+			return nullptr;
+		}
+
+		// The map owns the sections, it's only us who can't change them through a const this
+		mLastSection = const_cast<Section*>(&section->second);
+		mLastPosition = chunk;
+	}
+
+	index = (pos.x() - chunk * Chunk::CHUNK_WIDTH) * Chunk::MAX_HEIGHT + pos.y();
+
+	return mLastSection;
+}
+
+std::uint8_t FluidSimulation::getCell(const Eigen::Vector2i& pos) const {
+	int index;
+	const Section* const section = getSection(pos, index);
+	if (section == nullptr) {
+		return SOLID;
+	}
+
+	return section->mCells[index];
+}
+
+void FluidSimulation::queue(const Eigen::Vector2i& pos, const std::size_t fluid) {
+	int index;
+	Section* const section = getSection(pos, index);
+	if (section == nullptr || (section->mCells[index] & KIND) == SOLID || (section->mQueued[index] & (1 << fluid))) {
+		return;
+	}
+
+	section->mQueued[index] |= 1 << fluid;
+	mActive[fluid].emplace_back(pos);
+}
+
+void FluidSimulation::wake(const Eigen::Vector2i& pos) {
+	// Above, below and the sides look at the cell, the diagonals above look at it for support
+	for (int x = -1; x <= 1; ++x) {
+		for (int y = -1; y <= 1; ++y) {
+			for (std::size_t fluid = 0; fluid < FLUIDS.size(); ++fluid) {
+				queue(pos + Eigen::Vector2i(x, y), fluid);
+			}
+		}
+	}
+}
+
+void FluidSimulation::step(const std::size_t fluid) {
+	SDL_assert(mProcessing.empty() && mPending.empty());
+
+	// Everything queued from now on is for the next step
+	std::swap(mProcessing, mActive[fluid]);
+
+	// Look at everything first and then apply, so the order of the cells doesn't matter
+	for (const Eigen::Vector2i& pos : mProcessing) {
+		int index;
+		Section* const section = getSection(pos, index);
+		SDL_assert(section != nullptr);
+
+		section->mQueued[index] &= ~(1 << fluid);
+
+		if (const std::uint8_t cell = update(pos, fluid); cell != section->mCells[index]) {
+			mPending.emplace_back(pos, cell);
+		}
+	}
+
+	for (const auto& [pos, cell] : mPending) {
+		int index;
+		Section* const section = getSection(pos, index);
+
+		const std::uint8_t old = section->mCells[index];
+		section->mCells[index] = cell;
+
+		wake(pos);
+
+		// Sources harden into stone, the rest into cobblestone
+		const Components::Item type = (cell & KIND) == SOLID
+						      ? ((old & SOURCE) ? Components::Item::STONE : Components::Item::COBBLESTONE)
+						      : getItem(cell);
+
+		// Otherwise only the level changed
+		if (type != getItem(old)) {
+			mChanges.emplace_back(pos, type);
+		}
+	}
+
+	mProcessing.clear();
+	mPending.clear();
+}
+
+std::uint8_t FluidSimulation::update(const Eigen::Vector2i& pos, const std::size_t fluid) const {
+	const Fluid& type = FLUIDS[fluid];
+
+	const std::uint8_t cell = getCell(pos);
+	if ((cell & KIND) == SOLID) {
+		return cell;
+	}
+
+	// Lava touching water hardens, no matter which of the two flowed into the other
+	if ((cell & KIND) == FLUIDS[LAVA].mKind) {
+		for (const auto& direction : DIRECTIONS) {
+			if ((getCell(pos + direction) & KIND) == FLUIDS[WATER].mKind) {
+				return SOLID;
+			}
+		}
+	}
+
+	if ((cell & KIND) != EMPTY && (cell & KIND) != type.mKind) {
+		return cell;
+	}
+
+	if (cell & SOURCE) {
+		return cell;
+	}
+
+	// Any fluid that isn't falling holds the fluid above it up, only full flowing cells are falling
+	const auto isFloor = [](const std::uint8_t below) {
+		return (below & KIND) != EMPTY && ((below & SOURCE) || (below & LEVEL) < MAX_LEVEL);
+	};
+
+	// Falling fluid is full
+	std::uint8_t level = (getCell(pos + UP) & KIND) == type.mKind ? MAX_LEVEL : 0;
+
+	int sources = 0;
+	for (const auto& side : SIDES) {
+		const std::uint8_t neighbour = getCell(pos + side);
+		if ((neighbour & KIND) != type.mKind) {
+			continue;
+		}
+
+		if (neighbour & SOURCE) {
+			++sources;
+		}
+
+		// It falls instead of spreading
+		if (!isFloor(getCell(pos + side + DOWN))) {
+			continue;
+		}
+
+		if ((neighbour & LEVEL) > type.mDecay) {
+			level = std::max<std::uint8_t>(level, (neighbour & LEVEL) - type.mDecay);
+		}
+	}
+
+	if (level == 0) {
+		return EMPTY;
+	}
+
+	// Water between two sources becomes one, so pools fill up
+	if (fluid == WATER && sources == 2 && isFloor(getCell(pos + DOWN))) {
+		return type.mKind | SOURCE | MAX_LEVEL;
+	}
+
+	return type.mKind | level;
+}
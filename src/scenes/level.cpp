@@ -1,16 +1,25 @@
 #include "scenes/level.hpp"
 
 #include "components.hpp"
+#include "components/furnace.hpp"
 #include "components/inventory.hpp"
 #include "components/noise.hpp"
 #include "components/playerInventory.hpp"
 #include "game.hpp"
+#include "items.hpp"
 #include "managers/entityManager.hpp"
 #include "managers/systemManager.hpp"
 #include "opengl/texture.hpp"
+#include "registers.hpp"
 #include "scene.hpp"
+#include "scenes/blockTicker.hpp"
 #include "scenes/chunk.hpp"
+#include "scenes/chunkCache.hpp"
+#include "scenes/fluidSimulation.hpp"
+#include "scenes/lightEngine.hpp"
 #include "systems/UISystem.hpp"
+#include "systems/physicsSystem.hpp"
+#include "systems/renderSystem.hpp"
 #include "third_party/Eigen/Core"
 #include "third_party/rapidjson/allocators.h"
 #include "third_party/rapidjson/document.h"
@@ -21,10 +30,14 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 Level::Level(const std::string& name)
-	: mName(name), mTextID(0), mLeft(nullptr), mCenter(nullptr), mRight(nullptr), mGame(Game::getInstance()),
-	  mScene(nullptr), mNoise(new NoiseGenerator()) {}
+	: mName(name), mTextID(0), mTickTime(0), mLeft(nullptr), mCenter(nullptr), mRight(nullptr),
+	  mGame(Game::getInstance()), mScene(nullptr), mNoise(new NoiseGenerator()), mCache(new ChunkCache()),
+	  mLight(new LightEngine()), mTicker(new BlockTicker(this)), mFluids(new FluidSimulation()) {}
 
 Level::~Level() {
 	SDL_Log("Unloading level");
@@ -36,24 +49,21 @@ void Level::create() {
 
 	SDL_assert(mGame != nullptr);
 	mData.SetObject();
+	mCache->clear();
+	mLight->clear();
+	mGame->getSystemManager()->getRenderSystem()->clearChunks();
+	mTicker->clear();
+	mFluids->clear();
+	mTickTime = 0;
 
 	mScene = new Scene();
+	mScene->getSignal(PhysicsSystem::PHYSICS_DIRTY_SIGNAL) = true;
 
 	const auto player = mScene->newEntity();
 	mGame->setPlayerID(player);
 
 	createCommon();
 
-	mScene->emplace<Components::velocity>(player, Eigen::Vector2f(0.0f, 0.0f));
-	mScene->emplace<Components::position>(
-		player, Eigen::Vector2f(0.0f, (Chunk::WATER_LEVEL + 1 + (5 * mNoise->getNoise(0))) *
-						      Components::block::BLOCK_SIZE));
-	mScene->emplace<Components::inventory>(player, new PlayerInventory(mGame, 36));
-
-	mLeft = new Chunk(mScene, mNoise.get(), -1);
-	mCenter = new Chunk(mScene, mNoise.get(), 0);
-	mRight = new Chunk(mScene, mNoise.get(), 1);
-
 	mData.AddMember(rapidjson::StringRef(CHUNK_KEY), rapidjson::Value(rapidjson::kObjectType),
 			mData.GetAllocator());
 	mData.AddMember(rapidjson::StringRef(PLAYER_KEY), rapidjson::Value(rapidjson::kObjectType),
@@ -63,17 +73,50 @@ void Level::create() {
 
 	SDL_assert(mData.HasMember(PLAYER_KEY));
 	SDL_assert(mData.HasMember(CHUNK_KEY));
+
+	mLeft = mCenter = mRight = nullptr;
+	mLeft = loadChunk(-1);
+	mCenter = loadChunk(0);
+	mRight = loadChunk(1);
+
+	// Spawn on top of the first column
+	mScene->emplace<Components::velocity>(player, Eigen::Vector2f(0.0f, 0.0f));
+	mScene->emplace<Components::position>(
+		player, Eigen::Vector2f(0.0f, (surfaceAt(0) + 1) * Components::block::BLOCK_SIZE));
+	mScene->emplace<Components::inventory>(player, new PlayerInventory(mGame, 36));
+}
+
+void Level::create(const std::uint64_t seed) {
+	// Resets the random generator too, not just the seed
+	*mNoise = NoiseGenerator(seed);
+
+	create();
 }
 
 void Level::load(rapidjson::Value& data) {
 	delete mScene;
 
 	mData.CopyFrom(data, mData.GetAllocator());
+	mCache->clear();
+	mLight->clear();
+	mGame->getSystemManager()->getRenderSystem()->clearChunks();
+	mTicker->clear();
+	mFluids->clear();
+	mTickTime = 0;
+
+	// Older saves don't have ticks
+	if (mData.HasMember(TICKS_KEY)) {
+		mTicker->load(mData[TICKS_KEY]);
+	}
+	if (mData.HasMember(FLUIDS_KEY)) {
+		mFluids->load(mData[FLUIDS_KEY]);
+	}
 
 	SDL_assert(data.HasMember(PLAYER_KEY));
 	SDL_assert(data.HasMember(CHUNK_KEY));
 
 	mScene = new Scene();
+	mScene->getSignal(PhysicsSystem::PHYSICS_DIRTY_SIGNAL) = true;
 	const EntityID player = mScene->newEntity();
 	mGame->setPlayerID(player);
 
@@ -90,20 +133,14 @@ void Level::load(rapidjson::Value& data) {
 		const auto centerChunk =
 			static_cast<int>(playerPos) / Components::block::BLOCK_SIZE / Chunk::CHUNK_WIDTH - sign;
 
-		if (this->mData[CHUNK_KEY][sign ? "-" : "+"][SDL_abs(centerChunk)].IsNull()) {
-			SDL_Log("Chunk %d was Null! Making new chunk", centerChunk);
-			chunk = new Chunk(this->mScene, mNoise.get(), centerChunk);
-
-			return;
-		}
-
-		chunk = new Chunk(this->mData[CHUNK_KEY][sign ? "-" : "+"][SDL_abs(centerChunk)], this->mScene);
+		chunk = this->loadChunk(centerChunk);
 	};
 
 	const auto playerPos = getVector2f(mData[PLAYER_KEY]["position"]).x();
 	mScene->mMouse.count = mData[PLAYER_KEY]["mcount"].GetUint64();
 	mScene->mMouse.item = static_cast<Components::Item>(mData[PLAYER_KEY]["mitem"].GetUint64());
 
+	mLeft = mCenter = mRight = nullptr;
 	loadChunk(mCenter, playerPos);
 	loadChunk(mLeft, playerPos - Chunk::CHUNK_WIDTH * Components::block::BLOCK_SIZE + 0.1);
 	loadChunk(mRight, playerPos + Chunk::CHUNK_WIDTH * Components::block::BLOCK_SIZE + 0.1);
@@ -158,20 +195,19 @@ void Level::save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& alloc
 
 	mScene->erase(playerID);
 
+	for (const auto& chunk : mCache->flush()) {
+		writeBack(chunk);
+	}
+
 	const auto save = [this](Chunk* chunk) {
 		SDL_assert(chunk != nullptr);
 
-		while (this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"].Size() <=
-		       std::llabs(chunk->getPosition())) {
-			this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"].PushBack(
-				rapidjson::Value(rapidjson::kArrayType).SetObject().Move(), this->mData.GetAllocator());
-		}
+		auto& chunkData = this->getChunkData(chunk->getPosition());
+		chunkData.SetObject();
 
-		this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"][SDL_abs(chunk->getPosition())].SetObject();
-
-		chunk->save(this->mScene,
-			    this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"][SDL_abs(chunk->getPosition())],
-			    this->mData.GetAllocator());
+		chunk->save(this->mScene, chunkData, this->mData.GetAllocator());
+		this->mTicker->removeChunk(chunk->getPosition());
+		this->mFluids->removeChunk(chunk->getPosition());
 
 		delete chunk;
 	};
@@ -179,6 +215,24 @@ void Level::save(rapidjson::Value& data, rapidjson::MemoryPoolAllocator<>& alloc
 	save(mLeft);
 	save(mCenter);
 	save(mRight);
+	mLight->clear();
+	mGame->getSystemManager()->getRenderSystem()->clearChunks();
+
+	rapidjson::Value ticks;
+	mTicker->save(ticks, mData.GetAllocator());
+	if (mData.HasMember(TICKS_KEY)) {
+		mData[TICKS_KEY] = ticks.Move();
+	} else {
+		mData.AddMember(rapidjson::StringRef(TICKS_KEY), ticks.Move(), mData.GetAllocator());
+	}
+
+	rapidjson::Value fluids;
+	mFluids->save(fluids, mData.GetAllocator());
+	if (mData.HasMember(FLUIDS_KEY)) {
+		mData[FLUIDS_KEY] = fluids.Move();
+	} else {
+		mData.AddMember(rapidjson::StringRef(FLUIDS_KEY), fluids.Move(), mData.GetAllocator());
+	}
 
 	data.CopyFrom(mData.Move(), allocator);
 }
@@ -192,6 +246,15 @@ void Level::update(const float delta) {
 
 	mScene->get<Components::text>(mTextID).mID = "AD" + std::to_string(mLastTime / ROLL_TIME);
 
+	mTickTime += delta;
+	while (mTickTime >= BlockTicker::TICK_LENGTH) {
+		mTickTime -= BlockTicker::TICK_LENGTH;
+
+		mTicker->tick();
+		mFluids->tick(mTicker->getTick());
+		applyFluids();
+	}
+
 	const auto playerID = mGame->getPlayerID();
 
 	const auto playerX = static_cast<int>(mScene->get<Components::position>(playerID).mPosition.x());
@@ -203,72 +266,98 @@ void Level::update(const float delta) {
 		return;
 	}
 
-	const auto pad = [this](std::int64_t position) {
-		while (this->mData[CHUNK_KEY][position < 0 ? "-" : "+"].Size() <= std::llabs(position)) {
-			this->mData[CHUNK_KEY][position < 0 ? "-" : "+"].PushBack(
-				rapidjson::Value(rapidjson::kArrayType).SetObject().Move(), this->mData.GetAllocator());
-		}
-	};
+	if (currentChunk == mLeft->getPosition()) {
+		unloadChunk(mRight);
 
-	const auto save = [this, &pad](Chunk* chunk) {
-		pad(chunk->getPosition());
+		mRight = mCenter;
+		mCenter = mLeft;
+		mLeft = loadChunk(currentChunk - 1);
+	} else if (currentChunk == mRight->getPosition()) {
+		unloadChunk(mLeft);
 
-		this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"][SDL_abs(chunk->getPosition())].SetObject();
+		mLeft = mCenter;
+		mCenter = mRight;
+		mRight = loadChunk(currentChunk + 1);
+	} else {
+		SDL_Log("\033[33mOut of boundary for chunk %d, loaded chunks: %" PRIi64 " %" PRIi64 " %" PRIi64
+			"\033[0m",
+			currentChunk, mLeft->getPosition(), mCenter->getPosition(), mRight->getPosition());
 
-		chunk->save(this->mScene,
-			    this->mData[CHUNK_KEY][chunk->getPosition() < 0 ? "-" : "+"][SDL_abs(chunk->getPosition())],
-			    this->mData.GetAllocator());
+		unloadChunk(mLeft);
+		unloadChunk(mCenter);
+		unloadChunk(mRight);
+		mLeft = mCenter = mRight = nullptr;
 
-		delete chunk;
-	};
+		mLeft = loadChunk(currentChunk - 1);
+		mCenter = loadChunk(currentChunk);
+		mRight = loadChunk(currentChunk + 1);
+	}
+}
 
-	if (currentChunk == mLeft->getPosition()) {
-		save(mRight);
+rapidjson::Value& Level::getChunkData(const std::int64_t position) {
+	auto& chunks = mData[CHUNK_KEY][position < 0 ? "-" : "+"];
 
-		mRight = mCenter;
-		mCenter = mLeft;
+	while (chunks.Size() <= std::llabs(position)) {
+		chunks.PushBack(rapidjson::Value(rapidjson::kArrayType).SetObject().Move(), mData.GetAllocator());
+	}
 
-		pad(currentChunk - 1);
-		const auto& chunkData = mData[CHUNK_KEY][(currentChunk - 1) < 0 ? "-" : "+"][SDL_abs(currentChunk - 1)];
-		if (chunkData.IsNull() || !chunkData.HasMember("blocks")) {
-			SDL_LogInfo(SDL_LOG_CATEGORY_CUSTOM, "\033[31mGenerating new chunk for chunk %d\033[0m",
-				    currentChunk - 1);
+	return chunks[std::llabs(position)];
+}
 
-			mLeft = new Chunk(mScene, mNoise.get(), currentChunk - 1);
-		} else {
-			mLeft = new Chunk(chunkData, mScene);
-		}
-	} else if (currentChunk == mRight->getPosition()) {
-		save(mLeft);
+Chunk* Level::loadChunk(const std::int64_t position) {
+	Chunk* chunk = nullptr;
+	Chunk::Packed packed;
 
-		mLeft = mCenter;
-		mCenter = mRight;
+	if (mCache->take(position, packed)) {
+		chunk = new Chunk(packed, mScene);
+	} else if (const auto& chunkData = getChunkData(position);
+		   chunkData.IsNull() || !chunkData.HasMember("blocks")) {
+		SDL_LogInfo(SDL_LOG_CATEGORY_CUSTOM, "\033[31mGenerating new chunk for chunk %" PRIi64 "\033[0m",
+			    position);
 
-		pad(currentChunk + 1);
-		const auto& chunkData = mData[CHUNK_KEY][(currentChunk + 1) < 0 ? "-" : "+"][SDL_abs(currentChunk + 1)];
-		if (chunkData.IsNull() || !chunkData.HasMember("blocks")) {
-			SDL_LogInfo(SDL_LOG_CATEGORY_CUSTOM, "\033[31mGenerating new chunk for chunk %d\033[0m",
-				    currentChunk + 1);
+		chunk = new Chunk(mScene, mNoise.get(), position);
 
-			mRight = new Chunk(mScene, mNoise.get(), currentChunk + 1);
-		} else {
-			mRight = new Chunk(chunkData, mScene);
+		// Trees reaching into the loaded neighbours
+		for (const auto& [type, pos] : chunk->takeOverflow()) {
+			blockPlaced(pos, type);
 		}
 	} else {
-		SDL_Log("\033[33mOut of boundary for chunk %d, loaded chunks: %" PRIi64 " %" PRIi64 " %" PRIi64
-			"\033[0m",
-			currentChunk, mLeft->getPosition(), mCenter->getPosition(), mRight->getPosition());
+		chunk = new Chunk(chunkData, mScene);
+	}
+
+	mLight->addChunk(position, chunk->getTiles());
+	mGame->getSystemManager()->getPhysicsSystem()->chunkChanged(position);
+	mGame->getSystemManager()->getRenderSystem()->chunkLoaded(position);
+	mTicker->addChunk(position);
+	mFluids->addChunk(position, chunk->getTiles());
+
+	return chunk;
+}
 
-		save(mLeft);
-		save(mCenter);
-		save(mRight);
+void Level::unloadChunk(Chunk* chunk) {
+	SDL_assert(chunk != nullptr);
 
-		mLeft = new Chunk(mScene, mNoise.get(), currentChunk - 1);
-		mCenter = new Chunk(mScene, mNoise.get(), currentChunk);
-		mRight = new Chunk(mScene, mNoise.get(), currentChunk + 1);
+	Chunk::Packed packed;
+	chunk->save(mScene, packed);
+	mLight->removeChunk(chunk->getPosition());
+	mGame->getSystemManager()->getPhysicsSystem()->chunkChanged(chunk->getPosition());
+	mGame->getSystemManager()->getRenderSystem()->chunkUnloaded(chunk->getPosition());
+	mTicker->removeChunk(chunk->getPosition());
+	mFluids->removeChunk(chunk->getPosition());
+	delete chunk;
+
+	for (const auto& evicted : mCache->put(std::move(packed))) {
+		writeBack(evicted);
 	}
 }
 
+void Level::writeBack(const Chunk::Packed& chunk) {
+	auto& chunkData = getChunkData(chunk.mPosition);
+	chunkData.SetObject();
+
+	Chunk::save(chunk, chunkData, mData.GetAllocator());
+}
+
 void Level::createCommon() {
 	const auto player = mGame->getPlayerID();
 	auto* const playerTexture = mGame->getSystemManager()->getTexture("steve.png", true);
@@ -288,9 +377,9 @@ void Level::createCommon() {
 			vel.x() -= 100;
 		}
 
-		// Open inv
+		// Open inv, this runs in the ticks so it opens next frame
 		if (scene->getSignal(SDL_SCANCODE_E)) {
-			Game::getInstance()->getSystemManager()->getUISystem()->addScreen(
+			Game::getInstance()->getSystemManager()->getUISystem()->requestScreen(
 				scene->get<Components::inventory>(entity).mInventory);
 		}
 	});
@@ -302,3 +391,169 @@ void Level::createCommon() {
 }
 
 std::int64_t Level::getPosition() { return mCenter->getPosition(); }
+
+Chunk* Level::getChunk(const std::int64_t position) const {
+	for (Chunk* const chunk : {mLeft, mCenter, mRight}) {
+		if (chunk != nullptr && chunk->getPosition() == position) {
+			return chunk;
+		}
+	}
+
+	return nullptr;
+}
+
+std::int64_t Level::surfaceAt(const std::int64_t x) const {
+	const Chunk* const chunk = getChunk(Chunk::getChunk(x));
+	if (chunk == nullptr) {
+		return Chunk::NO_SURFACE;
+	}
+
+	return chunk->getSurface(x);
+}
+
+bool Level::isSkyVisible(const std::int64_t x, const std::int64_t y) const { return y > surfaceAt(x); }
+
+void Level::blockPlaced(const Eigen::Vector2i& pos, const Components::Item type, const EntityID entity) {
+	if (type == Components::Item::FURNACE) {
+		static_cast<FurnaceInventory*>(registers::CLICKABLES.at(Components::Item::FURNACE)())
+			->placed(mTicker->getTick());
+	}
+
+	changeTile(pos, type);
+	mFluids->setTile(pos, type);
+
+	if (Chunk* const chunk = getChunk(Chunk::getChunk(pos.x())); chunk != nullptr && entity != MAX_ENTITIES) {
+		chunk->setEntity(pos, entity);
+	}
+}
+
+void Level::blockBroken(const Eigen::Vector2i& pos) {
+	changeTile(pos, Components::AIR());
+	mFluids->setTile(pos, Components::AIR());
+}
+
+void Level::changeTile(const Eigen::Vector2i& pos, const Components::Item type) {
+	Chunk* const chunk = getChunk(Chunk::getChunk(pos.x()));
+	if (chunk == nullptr) {
+		return;
+	}
+
+	const Components::Item old = chunk->getTile(pos);
+	if (type == Components::AIR()) {
+		chunk->blockBroken(mScene, pos);
+	} else {
+		chunk->blockPlaced(pos, type);
+	}
+
+	mLight->setTile(pos, type);
+	mGame->getSystemManager()->getPhysicsSystem()->tileChanged(pos);
+	mGame->getSystemManager()->getRenderSystem()->tileChanged(pos);
+	mTicker->blockChanged(pos, old, type);
+}
+
+void Level::applyFluids() {
+	const auto& changes = mFluids->getChanges();
+	if (changes.empty()) {
+		return;
+	}
+
+	const auto key = [](const Eigen::Vector2i& pos) {
+		return static_cast<std::uint64_t>(pos.x()) << 32 | static_cast<std::uint32_t>(pos.y());
+	};
+
+	// A single pass over the blocks for the whole step
+	std::unordered_set<std::uint64_t> positions;
+	for (const auto& [pos, type] : changes) {
+		positions.insert(key(pos));
+	}
+
+	std::vector<EntityID> replaced;
+	for (const auto& [entity, block] : mScene->view<Components::block>().each()) {
+		if (positions.contains(key(block.mPosition))) {
+			replaced.emplace_back(entity);
+		}
+	}
+
+	for (const EntityID entity : replaced) {
+		mScene->erase(entity);
+	}
+
+	for (const auto& [pos, type] : changes) {
+		if (type != Components::AIR()) {
+			const EntityID entity = Chunk::spawnBlock(mScene, type, pos);
+			if (Chunk* const chunk = getChunk(Chunk::getChunk(pos.x())); chunk != nullptr) {
+				chunk->setEntity(pos, entity);
+			}
+		}
+
+		changeTile(pos, type);
+	}
+}
+
+std::uint8_t Level::getLight(const Eigen::Vector2i& pos) const { return mLight->getLight(pos); }
+
+Components::Item Level::getTile(const Eigen::Vector2i& pos) const {
+	const Chunk* const chunk = getChunk(Chunk::getChunk(pos.x()));
+	if (chunk == nullptr) {
+		return Components::AIR();
+	}
+
+	return chunk->getTile(pos);
+}
+
+const Chunk::Grid* Level::getTiles(const std::int64_t position) const {
+	const Chunk* const chunk = getChunk(position);
+	if (chunk == nullptr) {
+		return nullptr;
+	}
+
+	return &chunk->getTiles();
+}
+
+void Level::setBlock(const Eigen::Vector2i& pos, const Components::Item type) {
+	if (getChunk(Chunk::getChunk(pos.x())) == nullptr) {
+		return;
+	}
+
+	if (const EntityID entity = findBlock(pos); entity != MAX_ENTITIES) {
+		mScene->erase(entity);
+		blockBroken(pos);
+	}
+
+	if (type == Components::AIR()) {
+		return;
+	}
+
+	blockPlaced(pos, type, Chunk::spawnBlock(mScene, type, pos));
+}
+
+EntityID Level::findBlock(const Eigen::Vector2i& pos) {
+	Chunk* const chunk = getChunk(Chunk::getChunk(pos.x()));
+	if (chunk == nullptr) {
+		return MAX_ENTITIES;
+	}
+
+	// Inside the grid the chunk knows the tile, and usually the entity
+	if (pos.y() >= 0 && pos.y() < Chunk::MAX_HEIGHT) {
+		if (chunk->getTile(pos) == Components::AIR()) {
+			return MAX_ENTITIES;
+		}
+
+		if (const EntityID entity = chunk->getEntity(pos);
+		    entity != MAX_ENTITIES && mScene->contains<Components::block>(entity) &&
+		    mScene->get<Components::block>(entity).mPosition == pos) {
+			return entity;
+		}
+	}
+
+	// Above the grid, or placed without telling the chunk
+	for (const auto& [entity, block] : mScene->view<Components::block>().each()) {
+		if (block.mPosition == pos) {
+			chunk->setEntity(pos, entity);
+
+			return entity;
+		}
+	}
+
+	return MAX_ENTITIES;
+}
@@ -0,0 +1,308 @@
+#include "scenes/lightEngine.hpp"
+
+#include "components.hpp"
+#include "registers.hpp"
+#include "scenes/chunk.hpp"
+#include "third_party/Eigen/Core"
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+
+namespace {
+const Eigen::Vector2i DOWN(0, -1);
+const Eigen::Vector2i DIRECTIONS[] = {{1, 0}, {-1, 0}, {0, 1}, DOWN};
+} // namespace
+
+LightEngine::LightEngine() : mLastSection(nullptr), mLastPosition(0) {}
+
+void LightEngine::addChunk(const std::int64_t position, const Chunk::Grid& tiles) {
+	SDL_assert(!mSections.contains(position));
+
+	Section& section = mSections[position];
+	section.mLight.fill(0);
+
+	for (int i = 0; i < SIZE; ++i) {
+		section.mTiles[i] = getTileFlags(tiles[i]);
+	}
+
+	const std::int64_t offset = position * Chunk::CHUNK_WIDTH;
+
+	// Sky light falls straight down until it hits something
+	for (int x = 0; x < Chunk::CHUNK_WIDTH; ++x) {
+		for (int y = Chunk::MAX_HEIGHT - 1; y >= 0; --y) {
+			const int index = x * Chunk::MAX_HEIGHT + y;
+			if (section.mTiles[index] & OPAQUE) {
+				break;
+			}
+
+			setChannel(section.mLight[index], Channel::SKY, MAX_LIGHT);
+			mQueue.emplace_back(x + offset, y);
+		}
+	}
+
+	// Pull in the light of the neighbours
+	for (const std::int64_t x : {offset - 1, offset + Chunk::CHUNK_WIDTH}) {
+		if (!mSections.contains(Chunk::getChunk(x))) {
+			continue;
+		}
+
+		for (int y = 0; y < Chunk::MAX_HEIGHT; ++y) {
+			mQueue.emplace_back(x, y);
+		}
+	}
+
+	propagate(Channel::SKY);
+
+	for (int i = 0; i < SIZE; ++i) {
+		if (const std::uint8_t emitted = section.mTiles[i] & 0x0F; emitted != 0) {
+			setChannel(section.mLight[i], Channel::BLOCK, emitted);
+			mQueue.emplace_back(i / Chunk::MAX_HEIGHT + offset, i % Chunk::MAX_HEIGHT);
+		}
+	}
+
+	for (const std::int64_t x : {offset - 1, offset + Chunk::CHUNK_WIDTH}) {
+		if (!mSections.contains(Chunk::getChunk(x))) {
+			continue;
+		}
+
+		for (int y = 0; y < Chunk::MAX_HEIGHT; ++y) {
+			mQueue.emplace_back(x, y);
+		}
+	}
+
+	propagate(Channel::BLOCK);
+}
+
+void LightEngine::removeChunk(const std::int64_t position) {
+	mSections.erase(position);
+
+	mLastSection = nullptr;
+}
+
+void LightEngine::clear() {
+	mSections.clear();
+
+	mLastSection = nullptr;
+}
+
+void LightEngine::setTile(const Eigen::Vector2i& pos, const Components::Item type) {
+	int index;
+	Section* const section = getSection(pos, index);
+	if (section == nullptr) {
+		return;
+	}
+
+	section->mTiles[index] = getTileFlags(type);
+
+	relight(pos, Channel::SKY);
+	relight(pos, Channel::BLOCK);
+}
+
+std::uint8_t LightEngine::getLight(const Eigen::Vector2i& pos) const {
+	const std::uint8_t sky = getSkyLight(pos);
+	const std::uint8_t block = getBlockLight(pos);
+
+	return sky > block ? sky : block;
+}
+
+std::uint8_t LightEngine::getSkyLight(const Eigen::Vector2i& pos) const {
+	if (pos.y() >= Chunk::MAX_HEIGHT) {
+		return MAX_LIGHT;
+	}
+
+	int index;
+	const Section* const section = getSection(pos, index);
+	if (section == nullptr) {
+		return 0;
+	}
+
+	return getChannel(section->mLight[index], Channel::SKY);
+}
+
+std::uint8_t LightEngine::getBlockLight(const Eigen::Vector2i& pos) const {
+	int index;
+	const Section* const section = getSection(pos, index);
+	if (section == nullptr) {
+		return 0;
+	}
+
+	return getChannel(section->mLight[index], Channel::BLOCK);
+}
+
+std::uint8_t LightEngine::getTileFlags(const Components::Item type) {
+	std::uint8_t flags = 0;
+
+	if (Chunk::isSolid(type)) {
+		flags |= OPAQUE;
+	}
+
+	if (registers::LIGHT_LEVELS.contains(type)) {
+		flags |= registers::LIGHT_LEVELS.at(type) & 0x0F;
+	}
+
+	return flags;
+}
+
+LightEngine::Section* LightEngine::getSection(const Eigen::Vector2i& pos, int& index) const {
+	if (pos.y() < 0 || pos.y() >= Chunk::MAX_HEIGHT) {
+		return nullptr;
+	}
+
+	const std::int64_t chunk = Chunk::getChunk(pos.x());
+	if (mLastSection == nullptr || mLastPosition != chunk) {
+		const auto section = mSections.find(chunk);
+		if (section == mSections.end()) {
+			return nullptr;
+		}
+
+		// The map owns the sections, it's only us who can't change them through a const this
+		mLastSection = const_cast<Section*>(&section->second);
+		mLastPosition = chunk;
+	}
+
+	index = (pos.x() - chunk * Chunk::CHUNK_WIDTH) * Chunk::MAX_HEIGHT + pos.y();
+
+	return mLastSection;
+}
+
+void LightEngine::propagate(const Channel channel) {
+	// Plain BFS, the queue grows while we walk it
+	for (std::uint64_t i = 0; i < mQueue.size(); ++i) {
+		const Eigen::Vector2i pos = mQueue[i];
+
+		int index;
+		Section* section = getSection(pos, index);
+		if (section == nullptr) {
+			continue;
+		}
+
+		const std::uint8_t level = getChannel(section->mLight[index], channel);
+		const std::uint8_t tile = section->mTiles[index];
+
+		// Opaque blocks get lit but don't pass the light on, unless they glow themselves
+		if (level <= 1 || ((tile & OPAQUE) && (tile & 0x0F) == 0)) {
+			continue;
+		}
+
+		for (const auto& direction : DIRECTIONS) {
+			const Eigen::Vector2i next = pos + direction;
+
+			int nextIndex;
+			Section* const nextSection = getSection(next, nextIndex);
+			if (nextSection == nullptr) {
+				continue;
+			}
+
+			const bool opaque = nextSection->mTiles[nextIndex] & OPAQUE;
+			std::uint8_t nextLevel;
+			if (channel == Channel::SKY && level == MAX_LIGHT && direction == DOWN && !opaque) {
+				// Sky light doesn't fade going down
+				nextLevel = MAX_LIGHT;
+			} else {
+				const std::uint8_t cost = opaque ? OPAQUE_COST : TRANSPARENT_COST;
+				nextLevel = level > cost ? level - cost : 0;
+			}
+
+			if (getChannel(nextSection->mLight[nextIndex], channel) >= nextLevel) {
+				continue;
+			}
+
+			setChannel(nextSection->mLight[nextIndex], channel, nextLevel);
+			mQueue.emplace_back(next);
+		}
+	}
+
+	mQueue.clear();
+}
+
+void LightEngine::unpropagate(const Channel channel) {
+	for (std::uint64_t i = 0; i < mRemoveQueue.size(); ++i) {
+		const auto [pos, level] = mRemoveQueue[i];
+
+		// The changed cell might have lit its neighbours, other opaque blocks didn't, they only need to be lit
+		// again by whatever is left around them
+		if (i != 0) {
+			int index;
+			const Section* const section = getSection(pos, index);
+			if (section != nullptr && (section->mTiles[index] & OPAQUE) &&
+			    (section->mTiles[index] & 0x0F) == 0) {
+				for (const auto& direction : DIRECTIONS) {
+					mQueue.emplace_back(pos + direction);
+				}
+
+				continue;
+			}
+		}
+
+		for (const auto& direction : DIRECTIONS) {
+			const Eigen::Vector2i next = pos + direction;
+
+			int nextIndex;
+			Section* const nextSection = getSection(next, nextIndex);
+			if (nextSection == nullptr) {
+				continue;
+			}
+
+			const std::uint8_t nextLevel = getChannel(nextSection->mLight[nextIndex], channel);
+			if (nextLevel == 0) {
+				continue;
+			}
+
+			const bool litByUs =
+				nextLevel < level ||
+				(channel == Channel::SKY && direction == DOWN && level == MAX_LIGHT && nextLevel == MAX_LIGHT);
+
+			if (!litByUs) {
+				// Brighter or as bright, refill from here
+				mQueue.emplace_back(next);
+
+				continue;
+			}
+
+			setChannel(nextSection->mLight[nextIndex], channel, 0);
+			mRemoveQueue.emplace_back(next, nextLevel);
+
+			// Other emitters are their own source
+			if (const std::uint8_t emitted = nextSection->mTiles[nextIndex] & 0x0F;
+			    channel == Channel::BLOCK && emitted != 0) {
+				setChannel(nextSection->mLight[nextIndex], channel, emitted);
+				mQueue.emplace_back(next);
+			}
+		}
+	}
+
+	mRemoveQueue.clear();
+}
+
+void LightEngine::relight(const Eigen::Vector2i& pos, const Channel channel) {
+	int index;
+	Section* const section = getSection(pos, index);
+	SDL_assert(section != nullptr);
+
+	const std::uint8_t level = getChannel(section->mLight[index], channel);
+	setChannel(section->mLight[index], channel, 0);
+
+	if (level != 0) {
+		mRemoveQueue.emplace_back(pos, level);
+		unpropagate(channel);
+	}
+
+	const std::uint8_t emitted = section->mTiles[index] & 0x0F;
+	if (channel == Channel::BLOCK && emitted != 0) {
+		setChannel(section->mLight[index], channel, emitted);
+		mQueue.emplace_back(pos);
+	}
+
+	// Open sky above the top of the grid
+	if (channel == Channel::SKY && pos.y() == Chunk::MAX_HEIGHT - 1 && !(section->mTiles[index] & OPAQUE)) {
+		setChannel(section->mLight[index], channel, MAX_LIGHT);
+		mQueue.emplace_back(pos);
+	}
+
+	// Let the neighbours flow back in
+	for (const auto& direction : DIRECTIONS) {
+		mQueue.emplace_back(pos + direction);
+	}
+
+	propagate(channel);
+}
@@ -1,12 +1,13 @@
 #include "systems/UISystem.hpp"
 
 #include "game.hpp"
+#include "opengl/glState.hpp"
 #include "opengl/mesh.hpp"
 #include "scene.hpp"
 #include "screens/screen.hpp"
 #include <cstddef>
 
-UISystem::UISystem() noexcept : mGame(Game::getInstance()), mMesh(nullptr) {
+UISystem::UISystem() noexcept : mGame(Game::getInstance()), mMesh(nullptr), mRequested(nullptr) {
 	constexpr const static float vertices[] = {
 		0.0f, 0.0f, // TL
 		0.0f, 1.0f, // BR
@@ -33,8 +34,8 @@ void UISystem::update(Scene* scene, const float delta) {
 }
 
 void UISystem::draw(Scene* scene) {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::blend(true);
+	GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	for (const auto& screen : mScreenStack) {
 		screen->draw(scene);
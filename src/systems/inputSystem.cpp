@@ -4,13 +4,17 @@
 #include "components/playerInventory.hpp"
 #include "game.hpp"
 #include "managers/eventManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/systemManager.hpp"
 #include "misc/sparse_set_view.hpp"
+#include "opengl/glState.hpp"
 #include "opengl/mesh.hpp"
 #include "opengl/shader.hpp"
 #include "opengl/texture.hpp"
 #include "registers.hpp"
 #include "scene.hpp"
+#include "scenes/fluidSimulation.hpp"
+#include "scenes/level.hpp"
 #include "systems/UISystem.hpp"
 #include "systems/physicsSystem.hpp"
 #include "third_party/Eigen/Core"
@@ -25,16 +29,25 @@
 
 InputSystem::InputSystem() noexcept : mGame(Game::getInstance()) {}
 
-void InputSystem::update(Scene* scene, const float delta) {
+void InputSystem::tick(Scene* scene, const float delta) {
 	if (!mGame->getSystemManager()->getUISystem()->empty()) {
 		return;
 	}
 
+	PhysicsSystem* const physics = mGame->getSystemManager()->getPhysicsSystem();
 	for (const auto& [entity, input] : scene->view<Components::input>().each()) {
 		SDL_assert(input.mFunction != nullptr);
 
+		// The function pushes it around, it needs its velocity back
+		physics->wake(scene, entity);
 		input.mFunction(scene, entity, delta);
 	}
+}
+
+void InputSystem::update(Scene* scene, const float delta) {
+	if (!mGame->getSystemManager()->getUISystem()->empty()) {
+		return;
+	}
 
 	updateMouse(scene, delta);
 }
@@ -44,7 +57,7 @@ void InputSystem::updateMouse(Scene* scene, const float) {
 
 	// From Topright
 	float mouseZ = 0, mouseY = 0;
-	SDL_GetMouseState(&mouseZ, &mouseY);
+	ReplayManager::getMouseState(&mouseZ, &mouseY);
 
 	// Convert Y to opengl cords
 	const auto windowSize = mGame->getSystemManager()->getDemensions();
@@ -78,10 +91,10 @@ void InputSystem::updateMouse(Scene* scene, const float) {
 	afterPlace:
 	}
 
-	static std::int64_t mLastHold = SDL_GetTicks();
+	static std::int64_t mLastHold = ReplayManager::getTicks();
 	const auto& handleLeftClick = [&]() {
 		if (mDestruction.pos != blockPos) {
-			mLastHold = SDL_GetTicks();
+			mLastHold = ReplayManager::getTicks();
 		}
 
 		mDestruction.pos = blockPos;
@@ -90,11 +103,11 @@ void InputSystem::updateMouse(Scene* scene, const float) {
 			return;
 		}
 
-		const auto pressLength =
-			(SDL_GetTicks() - std::max(mLastHold, scene->getSignal(EventManager::LEFT_HOLD_SIGNAL))) /
-			50.0f;
+		const auto pressLength = (ReplayManager::getTicks() -
+					  std::max(mLastHold, scene->getSignal(EventManager::LEFT_HOLD_SIGNAL))) /
+					 50.0f;
 		for (const auto& [entity, block] : scene->view<Components::block>().each()) {
-			if (block.mPosition != blockPos) {
+			if (block.mPosition != blockPos || FluidSimulation::isFluid(block.mType)) {
 				continue;
 			}
 
@@ -167,9 +180,7 @@ void InputSystem::updateMouse(Scene* scene, const float) {
 
 			scene->erase(entity);
 			scene->getSignal(EventManager::LEFT_HOLD_SIGNAL) = 0;
-
-			// Unused for the moment
-			scene->getSignal(PhysicsSystem::PHYSICS_DIRTY_SIGNAL) = true;
+			mGame->getLevel()->blockBroken(blockPos);
 
 			break;
 		}
@@ -178,23 +189,19 @@ void InputSystem::updateMouse(Scene* scene, const float) {
 	handleLeftClick();
 }
 
-void InputSystem::draw(class Scene* scene) {
+void InputSystem::draw(class Scene*) {
 	if (!mDestruction.render) {
 		return;
 	}
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_COLOR, GL_SRC_COLOR);
+	GLState::blend(true);
+	GLState::blendFunc(GL_SRC_COLOR, GL_SRC_COLOR);
 
 	const auto systemManager = mGame->getSystemManager();
-	const auto playerPos = scene->get<Components::position>(mGame->getPlayerID()).mPosition;
-	const Eigen::Vector2f cameraOffset = -playerPos + systemManager->getDemensions() / 2;
-
 	Shader* const shader = systemManager->getShader("single_block.vert", "block.frag");
 
 	shader->activate();
 	shader->set("texture_diffuse"_u, 0);
-	shader->set("offset"_u, cameraOffset);
 	shader->set("position"_u, mDestruction.pos);
 	shader->set("scale"_u, 1.0f);
 
@@ -207,7 +214,9 @@ void InputSystem::tryPlace(class Scene* scene, const Eigen::Vector2i& pos) {
 
 	auto* inv = static_cast<PlayerInventory*>(scene->get<Components::inventory>(mGame->getPlayerID()).mInventory);
 	for (const auto& block : scene->view<Components::block>()) {
-		if (scene->get<Components::block>(block).mPosition == pos) {
+		// Fluids get replaced
+		if (scene->get<Components::block>(block).mPosition == pos &&
+		    !FluidSimulation::isFluid(scene->get<Components::block>(block).mType)) {
 			return;
 		}
 	}
@@ -2,20 +2,22 @@
 
 #include "components.hpp"
 #include "components/inventory.hpp"
-#include "game.hpp"
 #include "managers/entityManager.hpp"
-#include "managers/systemManager.hpp"
-#include "opengl/texture.hpp"
+#include "misc/integration.hpp"
+#include "misc/sweep.hpp"
 #include "scene.hpp"
 #include "scenes/chunk.hpp"
-#include "scenes/level.hpp"
-#include "systems/UISystem.hpp"
 #include "third_party/Eigen/Core"
 #include "utils.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
+#include <vector>
 
 #ifdef IMGUI
 #include "imgui.h"
@@ -24,7 +26,10 @@
 #endif
 
 // The physicsSystem is in charge of the collision and mouvements
-PhysicsSystem::PhysicsSystem() noexcept : mGame(Game::getInstance()) {}
+PhysicsSystem::PhysicsSystem() noexcept : mCenter(0) {
+	mGrid.mLeft = 0;
+	mGrid.mTiles.fill(NO_BLOCK);
+}
 
 // Performance benchmark:
 // Before enabling checks (98f1275078cad77b0b7a3145b4e57c6f098bd078): 2560632.097561ns avg (391 FPS)
@@ -40,46 +45,70 @@ void PhysicsSystem::update(Scene* scene, const float delta) {
 	constexpr const static float G = 1200.0f;
 	constexpr const static float jumpForce = 600.0f;
 
-	if (!mGame->getSystemManager()->getUISystem()->empty()) {
-		return;
-	}
+	updateGrid(scene);
 
-	const auto blocks = scene->view<Components::collision, Components::block>();
-	for (const auto entity : scene->view<Components::position, Components::velocity>()) {
-		bool onGround = false;
-
-		if (scene->get<Components::velocity>(entity).mVelocity.y() < 1.0f) {
-			// Look cache for bellow block
-			if (!mCache.lastAbove.contains(entity) ||
-			    !scene->contains<Components::block>(mCache.lastAbove[entity]) ||
-			    !(onGround = collidingBellow(scene, entity, mCache.lastAbove[entity]))) {
-				for (const auto& block : blocks) {
-					if (collidingBellow(scene, entity, block)) {
-						onGround = true;
-						mCache.lastAbove[entity] = block;
-
-						break;
-					}
-				}
-			}
+	// Blocks outside of the grid are left to collide()
+	const auto boxes = [this, scene](const std::int64_t x, const std::int64_t y, const auto& visit) {
+		if (x < mGrid.mLeft || x >= mGrid.mLeft + GRID_WIDTH || y < 0 || y >= Chunk::MAX_HEIGHT) {
+			return;
 		}
 
-		auto& velocity = scene->get<Components::velocity>(entity).mVelocity;
-		if (onGround) {
+		const EntityID block = mGrid.mTiles[(x - mGrid.mLeft) * Chunk::MAX_HEIGHT + y];
+		if (block == NO_BLOCK) {
+			return;
+		}
+
+		const auto& collision = scene->get<Components::collision>(block);
+		const Eigen::Vector2f min =
+			Eigen::Vector2f(static_cast<float>(x), static_cast<float>(y)) * Components::block::BLOCK_SIZE +
+			collision.mOffset;
+		visit(min, Eigen::Vector2f(min + collision.mSize));
+	};
+
+	// Packed in columns, the math that's the same for every body runs on all of them at once
+	mBodies.clear();
+	for (const auto entity : scene->view<Components::position, Components::velocity>()) {
+		mBodies.emplace_back(entity);
+	}
+
+	mColumns.resize(static_cast<Eigen::Index>(mBodies.size()));
+	for (std::size_t i = 0; i < mBodies.size(); ++i) {
+		const EntityID entity = mBodies[i];
+		const Eigen::Vector2f& velocity = scene->get<Components::velocity>(entity).mVelocity;
+		const bool grounded = velocity.y() < 1.0f && onGround(scene, entity);
+
+		const Eigen::Vector2f& position = scene->get<Components::position>(entity).mPosition;
+		mColumns.mPositionX[i] = position.x();
+		mColumns.mPositionY[i] = position.y();
+		mColumns.mVelocityX[i] = velocity.x();
+		mColumns.mVelocityY[i] = velocity.y();
+		mColumns.mGrounded[i] = grounded;
+
+		if (grounded) {
 			// We can jump IF the entity is a misc entity with the jump flag, and the up key is pressed, and
 			// we are on the ground
-			if (entity == mGame->getPlayerID() && scene->getSignal(SDL_SCANCODE_SPACE)) {
-				velocity.y() = jumpForce;
+			if (scene->contains<Components::misc>(entity) &&
+			    (scene->get<Components::misc>(entity).mWhat & Components::misc::JUMP) &&
+			    scene->getSignal(SDL_SCANCODE_SPACE)) {
+				mColumns.mVelocityY[i] = jumpForce;
 			} else {
-				velocity.y() = 0.0f;
+				mColumns.mVelocityY[i] = 0.0f;
 			}
-		} else {
-			velocity.y() -= G * delta;
 		}
+	}
+
+	integration::gravity(mColumns, G, delta);
+	// Where the bodies end up if nothing is in the way, the ones that collide get swept there from where they were
+	integration::move(mColumns, delta);
+
+	for (std::size_t i = 0; i < mBodies.size(); ++i) {
+		const EntityID entity = mBodies[i];
+		const bool grounded = mColumns.mGrounded[i] != 0.0f;
+		Eigen::Vector2f velocity(mColumns.mVelocityX[i], mColumns.mVelocityY[i]);
 
 		if (scene->contains<Components::animated_texture>(entity)) {
 			auto& texture = scene->get<Components::animated_texture>(entity);
-			if (!onGround) {
+			if (!grounded) {
 				texture.mSelect = 2 * 8 + (velocity.y() > 0);
 			} else {
 				static float step = 0;
@@ -102,65 +131,106 @@ void PhysicsSystem::update(Scene* scene, const float delta) {
 			}
 		}
 
-		scene->get<Components::position>(entity).mPosition += velocity * delta;
-		velocity.x() *= 0.7;
+		// Swept against the tiles from where it was, so a long frame can't carry the entity through a wall
+		auto& position = scene->get<Components::position>(entity).mPosition;
+		const Eigen::Vector2f moved(mColumns.mPositionX[i], mColumns.mPositionY[i]);
+		if (scene->contains<Components::collision>(entity)) {
+			const auto& collision = scene->get<Components::collision>(entity);
+			const auto result = sweep::move(position + collision.mOffset, collision.mSize, moved - position,
+							Components::block::BLOCK_SIZE, boxes);
+
+			position = result.mPosition - collision.mOffset;
+			if (result.mHitX) {
+				mColumns.mVelocityX[i] = 0.0f;
+			}
+
+			if (result.mHitY) {
+				mColumns.mVelocityY[i] = 0.0f;
+			}
+		} else {
+			position = moved;
+		}
 	}
 
-	itemPhysics(scene);
-}
+	integration::friction(mColumns, 0.7f);
 
-void PhysicsSystem::collide(Scene* scene) {
-	// Populate cache once
-	const auto leftChunk = (mGame->getLevel()->getPosition() - 1) * Chunk::CHUNK_WIDTH;
+	for (std::size_t i = 0; i < mBodies.size(); ++i) {
+		const EntityID entity = mBodies[i];
+		auto& velocity = scene->get<Components::velocity>(entity).mVelocity;
+		velocity = Eigen::Vector2f(mColumns.mVelocityX[i], mColumns.mVelocityY[i]);
 
-	// Reset cache
-	for (auto& row : mCache.chunk) {
-		for (auto& block : row) {
-			block = 0;
+		// Only the entities nobody controls fall asleep
+		if (scene->contains<Components::input>(entity)) {
+			continue;
+		}
+
+		if (mColumns.mGrounded[i] != 0.0f && nearZero(velocity.x()) && velocity.y() == 0.0f) {
+			if (++mResting[entity] >= REST_TICKS) {
+				mToggled.emplace_back(entity);
+			}
+		} else {
+			mResting.erase(entity);
 		}
 	}
 
-	for (const auto& block : scene->view<Components::collision, Components::block>()) {
-		const auto pos = scene->get<Components::block>(block).mPosition;
-		mCache.chunk[pos.x() - leftChunk][pos.y()] = block;
+	for (const auto entity : mToggled) {
+		mResting.erase(entity);
+		scene->remove<Components::velocity>(entity);
+		scene->emplace<Components::sleeping>(entity);
+	}
+	mToggled.clear();
 
-		if (AABBxAABB(scene, mGame->getPlayerID(), block)) {
-			pushBack(scene, mGame->getPlayerID(), block);
-		}
+	itemPhysics(scene);
+}
+
+void PhysicsSystem::collide(Scene* scene) {
+	// Get a list of all the entities we need to check, sleeping ones don't move
+	const auto entities = scene->view<Components::collision, Components::position, Components::velocity>();
+
+	mBoxes.clear();
+	for (const auto entity : entities) {
+		const auto& collision = scene->get<Components::collision>(entity);
+		mBoxes.emplace_back(entity, scene->get<Components::position>(entity).mPosition + collision.mOffset,
+				    collision.mSize);
 	}
 
-	// Get a list of all the entities we need to check
-	const auto entities = scene->view<Components::collision, Components::position>();
-	for (const auto& entity : entities) {
-		const auto pos = scene->get<Components::position>(entity).mPosition;
-		const auto cell = mCache.chunk[(pos.x() / Components::block::BLOCK_SIZE) - leftChunk]
-					      [pos.y() / Components::block::BLOCK_SIZE];
-		if (cell) {
-			if (AABBxAABB(scene, entity, cell)) {
-				pushBack(scene, entity, cell);
+	// Every entity only moves its own box and reads the blocks, so the result doesn't depend on how the entities are
+	// split between the threads
+	mPool.forRanges(mBoxes.size(), COLLIDE_GRAIN, [this, scene](const std::size_t begin, const std::size_t end) {
+		thread_local std::vector<EntityID> blocks;
+
+		for (std::size_t i = begin; i < end; ++i) {
+			auto& box = mBoxes[i];
+
+			queryTiles(box.mMin, box.mMin + box.mSize, blocks);
+			for (const auto block : blocks) {
+				if (AABBxAABB(scene, box.mMin, box.mSize, block)) {
+					pushBack(scene, box.mMin, box.mSize, block);
+				}
 			}
 		}
-	}
+	});
 
-	/*
-	// Multithreading this will result in worse performance :(
-	for (const auto& entity : entities) {
+	for (const auto& box : mBoxes) {
+		scene->get<Components::position>(box.mEntity).mPosition =
+			box.mMin - scene->get<Components::collision>(box.mEntity).mOffset;
 	}
-	*/
+}
 
-	// Debug editor
+void PhysicsSystem::editor([[maybe_unused]] Scene* scene) {
 #if defined(IMGUI) && defined(DEBUG)
-	static bool editor = false;
+	static bool open = false;
 	ImGui::Begin("Developer menu");
-	ImGui::Checkbox("Collision box editor", &editor);
+	ImGui::Checkbox("Collision box editor", &open);
 	ImGui::End();
 
-	if (editor) {
+	if (open) {
 		scene->getSignal("collisionEditor"_u) = true;
 
 		ImGui::Begin("Collision editor");
 
-		for (const auto& entity : entities) {
+		for (const auto entity :
+		     scene->view<Components::collision, Components::position, Components::velocity>()) {
 			if (ImGui::TreeNode(std::format("Entity {}", entity).data())) {
 				if (scene->contains<Components::position>(entity)) {
 					ImGui::SliderFloat2(std::format("Position for entity {}", entity).data(),
@@ -191,11 +261,11 @@ void PhysicsSystem::collide(Scene* scene) {
 #endif
 }
 
-bool PhysicsSystem::AABBxAABB(const Scene* scene, const EntityID entityID, const EntityID blockID) const {
+bool PhysicsSystem::AABBxAABB(const Scene* scene, const Eigen::Vector2f& minA, const Eigen::Vector2f& size,
+			      const EntityID blockID) const {
 	using namespace Components;
 
-	const Eigen::Vector2f minA = scene->get<position>(entityID).mPosition + scene->get<collision>(entityID).mOffset;
-	const Eigen::Vector2f maxA = minA + scene->get<collision>(entityID).mSize;
+	const Eigen::Vector2f maxA = minA + size;
 
 	const auto& blockCollision = scene->get<collision>(blockID);
 	Eigen::Vector2f minB = scene->get<block>(blockID).mPosition.template cast<float>() * block::BLOCK_SIZE;
@@ -246,6 +316,35 @@ bool PhysicsSystem::collidingBellow(const class Scene* scene, const EntityID ent
 	return false;
 }
 
+bool PhysicsSystem::onGround(Scene* scene, const EntityID entity) {
+	if (!scene->contains<Components::collision>(entity)) {
+		return false;
+	}
+
+	// Look cache for bellow block
+	if (const auto cached = mCache.lastAbove.find(entity);
+	    cached != mCache.lastAbove.end() && scene->contains<Components::block>(cached->second) &&
+	    collidingBellow(scene, entity, cached->second)) {
+		return true;
+	}
+
+	// Only the tiles under the feet and the ones the entity is in can hold it up
+	const Eigen::Vector2f min =
+		scene->get<Components::position>(entity).mPosition + scene->get<Components::collision>(entity).mOffset;
+	const Eigen::Vector2f max = min + scene->get<Components::collision>(entity).mSize;
+	queryTiles(Eigen::Vector2f(min.x(), min.y() - 1.0f), max, mQuery);
+
+	for (const auto block : mQuery) {
+		if (collidingBellow(scene, entity, block)) {
+			mCache.lastAbove[entity] = block;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
 // TODO: Read
 // https://gamedev.stackexchange.com/questions/38891/making-an-efficient-collision-detection-system/38893#38893
 // TODO: Read
@@ -266,7 +365,8 @@ bool PhysicsSystem::collidingBellow(const class Scene* scene, const EntityID ent
  * 2. Both aren't static, thus push back both by half the overlap
  * (If the objects are both stationary, pass)
  */
-void PhysicsSystem::pushBack(class Scene* scene, const EntityID entity, EntityID block) {
+void PhysicsSystem::pushBack(const Scene* scene, Eigen::Vector2f& min, const Eigen::Vector2f& size,
+			     const EntityID block) const {
 	/*
 	 * Thx stack https://gamedev.stackexchange.com/questions/18302/2d-platformer-collisions
 	 * See
@@ -275,56 +375,280 @@ void PhysicsSystem::pushBack(class Scene* scene, const EntityID entity, EntityID
 	 */
 
 	// This is the position of our entity
-	const Eigen::Vector2f leftEntity =
-		scene->get<Components::position>(entity).mPosition + scene->get<Components::collision>(entity).mOffset;
-	const Eigen::Vector2f centerEntity = leftEntity + scene->get<Components::collision>(entity).mSize / 2;
+	const Eigen::Vector2f centerEntity = min + size / 2;
 
 	// And the position of the block
 	const auto& blockCollision = scene->get<Components::collision>(block);
-	const auto& blockTexture = scene->get<Components::texture>(block);
-	const auto& blockPosition = scene->get<Components::block>(block).mPosition;
-
 	const Eigen::Vector2f leftBlock =
-		Eigen::Vector2f(static_cast<float>(blockPosition.x()) * blockTexture.mTexture->getWidth(),
-				static_cast<float>(blockPosition.y()) * blockTexture.mTexture->getHeight()) +
+		scene->get<Components::block>(block).mPosition.template cast<float>() * Components::block::BLOCK_SIZE +
 		blockCollision.mOffset;
-	const Eigen::Vector2f centerB = leftBlock + scene->get<Components::collision>(block).mSize / 2;
+	const Eigen::Vector2f centerB = leftBlock + blockCollision.mSize / 2;
 
 	const Eigen::Vector2f distance = centerEntity - centerB;
-	const Eigen::Vector2f minDistance =
-		(scene->get<Components::collision>(entity).mSize + blockCollision.mSize) / 2;
+	const Eigen::Vector2f minDistance = (size + blockCollision.mSize) / 2;
 
-	SDL_assert(!(SDL_abs(distance.x()) > minDistance.x() || SDL_abs(distance.y()) > minDistance.y()) &&
+	SDL_assert(!(std::abs(distance.x()) > minDistance.x() || std::abs(distance.y()) > minDistance.y()) &&
 		   "The objects are not colliding?");
 
 	// Calculate the collision depth
 	const float depthX = (distance.x() > 0 ? minDistance.x() : -minDistance.x()) - distance.x();
 	const float depthY = (distance.y() > 0 ? minDistance.y() : -minDistance.y()) - distance.y();
 
-	const Eigen::Vector2f depth = Eigen::Vector2f(depthX, depthY);
-
-	if (SDL_abs(depth.x()) <= SDL_abs(depth.y())) {
-		scene->get<Components::position>(entity).mPosition.x() += depth.x();
+	if (std::abs(depthX) <= std::abs(depthY)) {
+		min.x() += depthX;
 	} else {
-		scene->get<Components::position>(entity).mPosition.y() += depth.y();
+		min.y() += depthY;
 	}
 }
 
+void PhysicsSystem::tileChanged(const Eigen::Vector2i& pos) { mDirty.mTiles.emplace_back(pos); }
+
+void PhysicsSystem::chunkChanged(const std::int64_t position) { mDirty.mChunks.emplace_back(position); }
+
+void PhysicsSystem::updateGrid(Scene* scene) {
+	if (scene->getSignal(PHYSICS_DIRTY_SIGNAL)) {
+		scene->getSignal(PHYSICS_DIRTY_SIGNAL) = false;
+
+		buildGrid(scene);
+
+		return;
+	}
+
+	// The loaded chunks moved, keep the columns still loaded
+	const std::int64_t left = (mCenter - 1) * Chunk::CHUNK_WIDTH;
+	if (const std::int64_t shift = left - mGrid.mLeft; shift != 0) {
+		auto& tiles = mGrid.mTiles;
+
+		if (std::abs(shift) >= GRID_WIDTH) {
+			tiles.fill(NO_BLOCK);
+		} else if (shift > 0) {
+			std::copy(tiles.begin() + shift * Chunk::MAX_HEIGHT, tiles.end(), tiles.begin());
+			std::fill(tiles.end() - shift * Chunk::MAX_HEIGHT, tiles.end(), NO_BLOCK);
+		} else {
+			std::copy_backward(tiles.begin(), tiles.end() + shift * Chunk::MAX_HEIGHT, tiles.end());
+			std::fill(tiles.begin(), tiles.begin() - shift * Chunk::MAX_HEIGHT, NO_BLOCK);
+		}
+
+		mGrid.mLeft = left;
+	}
+
+	if (mDirty.mTiles.empty() && mDirty.mChunks.empty()) {
+		return;
+	}
+
+	wakeAround(scene);
+
+	const auto tile = [this](const std::int64_t x, const std::int64_t y) -> EntityID* {
+		if (x < mGrid.mLeft || x >= mGrid.mLeft + GRID_WIDTH || y < 0 || y >= Chunk::MAX_HEIGHT) {
+			return nullptr;
+		}
+
+		return &mGrid.mTiles[(x - mGrid.mLeft) * Chunk::MAX_HEIGHT + y];
+	};
+
+	// Mark the changed tiles, then put back the blocks that are in them
+	for (const auto position : mDirty.mChunks) {
+		for (std::int64_t x = position * Chunk::CHUNK_WIDTH; x < (position + 1) * Chunk::CHUNK_WIDTH; ++x) {
+			if (EntityID* const column = tile(x, 0); column != nullptr) {
+				std::fill(column, column + Chunk::MAX_HEIGHT, DIRTY_BLOCK);
+			}
+		}
+	}
+
+	for (const auto& pos : mDirty.mTiles) {
+		if (EntityID* const changed = tile(pos.x(), pos.y()); changed != nullptr) {
+			*changed = DIRTY_BLOCK;
+		}
+	}
+
+	mGrid.mOutside.clear();
+	for (const auto& [entity, _, block] : scene->view<Components::collision, Components::block>().each()) {
+		EntityID* const changed = tile(block.mPosition.x(), block.mPosition.y());
+
+		if (changed == nullptr) {
+			mGrid.mOutside.emplace_back(entity);
+		} else if (*changed == DIRTY_BLOCK) {
+			*changed = entity;
+		}
+	}
+
+	std::ranges::replace(mGrid.mTiles, DIRTY_BLOCK, NO_BLOCK);
+
+	mDirty.mTiles.clear();
+	mDirty.mChunks.clear();
+}
+
+void PhysicsSystem::wake(Scene* scene, const EntityID entity) {
+	if (!scene->contains<Components::sleeping>(entity)) {
+		return;
+	}
+
+	scene->remove<Components::sleeping>(entity);
+	scene->emplace<Components::velocity>(entity, Eigen::Vector2f(0.0f, 0.0f));
+}
+
+void PhysicsSystem::wakeAround(Scene* scene) {
+	for (const auto entity : scene->view<Components::position, Components::collision, Components::sleeping>()) {
+		// The tiles it's in, the ones holding it up and the ones next to it
+		const Eigen::Vector2f min =
+			scene->get<Components::position>(entity).mPosition + scene->get<Components::collision>(entity).mOffset;
+		const Eigen::Vector2f max = min + scene->get<Components::collision>(entity).mSize;
+		const auto left = static_cast<std::int64_t>(std::floor(min.x() / Components::block::BLOCK_SIZE)) - 1;
+		const auto right = static_cast<std::int64_t>(std::floor(max.x() / Components::block::BLOCK_SIZE)) + 1;
+		const auto bottom = static_cast<std::int64_t>(std::floor(min.y() / Components::block::BLOCK_SIZE)) - 1;
+		const auto top = static_cast<std::int64_t>(std::floor(max.y() / Components::block::BLOCK_SIZE));
+
+		const bool tileChanged = std::ranges::any_of(mDirty.mTiles, [&](const Eigen::Vector2i& pos) {
+			return pos.x() >= left && pos.x() <= right && pos.y() >= bottom && pos.y() <= top;
+		});
+		const bool chunkChanged = std::ranges::any_of(mDirty.mChunks, [&](const std::int64_t position) {
+			return Chunk::getChunk(left) <= position && position <= Chunk::getChunk(right);
+		});
+
+		if (tileChanged || chunkChanged) {
+			mToggled.emplace_back(entity);
+		}
+	}
+
+	// Not while walking the view
+	for (const auto entity : mToggled) {
+		wake(scene, entity);
+	}
+	mToggled.clear();
+}
+
+void PhysicsSystem::buildGrid(Scene* scene) {
+	mGrid.mLeft = (mCenter - 1) * Chunk::CHUNK_WIDTH;
+	mGrid.mTiles.fill(NO_BLOCK);
+	mGrid.mOutside.clear();
+	mDirty.mTiles.clear();
+	mDirty.mChunks.clear();
+
+	for (const auto block : scene->view<Components::collision, Components::block>()) {
+		const auto& pos = scene->get<Components::block>(block).mPosition;
+		const std::int64_t x = pos.x() - mGrid.mLeft;
+
+		if (x < 0 || x >= GRID_WIDTH || pos.y() < 0 || pos.y() >= Chunk::MAX_HEIGHT) {
+			mGrid.mOutside.emplace_back(block);
+
+			continue;
+		}
+
+		mGrid.mTiles[x * Chunk::MAX_HEIGHT + pos.y()] = block;
+	}
+}
+
+void PhysicsSystem::queryTiles(const Eigen::Vector2f& min, const Eigen::Vector2f& max,
+			       std::vector<EntityID>& blocks) const {
+	blocks = mGrid.mOutside;
+
+	// Collision boxes stay inside of their tile
+	const std::int64_t left =
+		std::max<std::int64_t>(std::floor(min.x() / Components::block::BLOCK_SIZE) - mGrid.mLeft, 0);
+	const std::int64_t right =
+		std::min<std::int64_t>(std::floor(max.x() / Components::block::BLOCK_SIZE) - mGrid.mLeft, GRID_WIDTH - 1);
+	const std::int64_t bottom = std::max<std::int64_t>(std::floor(min.y() / Components::block::BLOCK_SIZE), 0);
+	const std::int64_t top =
+		std::min<std::int64_t>(std::floor(max.y() / Components::block::BLOCK_SIZE), Chunk::MAX_HEIGHT - 1);
+
+	for (std::int64_t x = left; x <= right; ++x) {
+		for (std::int64_t y = bottom; y <= top; ++y) {
+			if (const EntityID block = mGrid.mTiles[x * Chunk::MAX_HEIGHT + y]; block != NO_BLOCK) {
+				blocks.emplace_back(block);
+			}
+		}
+	}
+}
+
+std::uint64_t PhysicsSystem::itemCell(const Eigen::Vector2f& position, const int dx, const int dy) {
+	const auto x = static_cast<std::int32_t>(std::floor(position.x() / ITEM_CELL_SIZE)) + dx;
+	const auto y = static_cast<std::int32_t>(std::floor(position.y() / ITEM_CELL_SIZE)) + dy;
+
+	return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32 | static_cast<std::uint32_t>(y);
+}
+
 void PhysicsSystem::itemPhysics(class Scene* scene) {
-	const auto players = scene->view<Components::position, Components::inventory>();
-	for (const auto item : scene->view<Components::position, Components::item>()) {
-		// Soo test the blocks with items, only if it's close
-		// Picking the stuff up
-		for (const auto entity : players) {
-			if ((scene->get<Components::position>(item).mPosition -
-			     scene->get<Components::position>(entity).mPosition)
-				    .squaredNorm() < PICK_UP_RANGE_SQ) {
-				if (scene->get<Components::inventory>(entity).mInventory->tryPick(scene, item)) {
-					scene->erase(item);
-
-					break;
+	// Cells that stayed empty for a whole tick
+	std::erase_if(mItemCells, [](const auto& cell) { return cell.second.empty(); });
+	for (auto& [_, items] : mItemCells) {
+		items.clear();
+	}
+
+	for (const auto& [item, position, _] : scene->view<Components::position, Components::item>().each()) {
+		mItemCells[itemCell(position.mPosition)].emplace_back(item);
+	}
+
+	// Calls func with every item in the cells around position
+	const auto around = [this](const Eigen::Vector2f& position, const auto& func) {
+		for (int dx = -1; dx <= 1; ++dx) {
+			for (int dy = -1; dy <= 1; ++dy) {
+				const auto cell = mItemCells.find(itemCell(position, dx, dy));
+				if (cell == mItemCells.end()) {
+					continue;
+				}
+
+				for (const auto item : cell->second) {
+					func(item);
 				}
 			}
 		}
+	};
+
+	// Stacks of the same item lying next to each other become one
+	for (const auto item : scene->view<Components::position, Components::item>()) {
+		auto& stack = scene->get<Components::item>(item);
+		if (stack.mCount == 0) {
+			continue;
+		}
+
+		const Eigen::Vector2f& position = scene->get<Components::position>(item).mPosition;
+		around(position, [&](const EntityID other) {
+			if (other == item || !scene->contains<Components::item>(other)) {
+				return;
+			}
+
+			auto& otherStack = scene->get<Components::item>(other);
+			if (otherStack.mCount == 0 || otherStack.mType != stack.mType ||
+			    (scene->get<Components::position>(other).mPosition - position).squaredNorm() >= MERGE_RANGE_SQ) {
+				return;
+			}
+
+			stack.mCount += otherStack.mCount;
+			otherStack.mCount = 0;
+			mToggled.emplace_back(item);
+		});
+	}
+
+	// The stack that grew might have been asleep under a falling one, it settles again like a dropped one
+	for (const auto item : mToggled) {
+		wake(scene, item);
+		mResting.erase(item);
+	}
+	mToggled.clear();
+
+	// Only the items around a player can get picked up
+	for (const auto& [entity, position, inventory] :
+	     scene->view<Components::position, Components::inventory>().each()) {
+		around(position.mPosition, [&](const EntityID item) {
+			if (!scene->contains<Components::item>(item) || scene->get<Components::item>(item).mCount == 0 ||
+			    (scene->get<Components::position>(item).mPosition - position.mPosition).squaredNorm() >=
+				    PICK_UP_RANGE_SQ) {
+				return;
+			}
+
+			if (inventory.mInventory->tryPick(scene, item)) {
+				scene->get<Components::item>(item).mCount = 0;
+			}
+		});
+	}
+
+	// Merged and picked up stacks
+	for (const auto& [_, items] : mItemCells) {
+		for (const auto item : items) {
+			if (scene->contains<Components::item>(item) && scene->get<Components::item>(item).mCount == 0) {
+				mResting.erase(item);
+				scene->erase(item);
+			}
+		}
 	}
 }
@@ -4,24 +4,36 @@
 #include "components/inventory.hpp"
 #include "components/playerInventory.hpp"
 #include "game.hpp"
+#include "items.hpp"
 #include "managers/glManager.hpp"
+#include "managers/replayManager.hpp"
 #include "managers/shaderManager.hpp"
 #include "managers/systemManager.hpp"
 #include "managers/textureManager.hpp"
 #include "misc/sparse_set_view.hpp"
+#include "opengl/chunkMesh.hpp"
 #include "opengl/framebuffer.hpp"
+#include "opengl/glState.hpp"
 #include "opengl/mesh.hpp"
+#include "opengl/renderQueue.hpp"
 #include "opengl/shader.hpp"
+#include "opengl/spriteBatch.hpp"
 #include "opengl/texture.hpp"
 #include "opengl/ubo.hpp"
 #include "registers.hpp"
 #include "scene.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/level.hpp"
+#include "scenes/lightEngine.hpp"
 #include "third_party/Eigen/Geometry"
 #include "third_party/glad/glad.h"
 #include "utils.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <span>
 #include <utility>
@@ -49,7 +61,9 @@ EM_JS(int, browserWidth, (), { return window.innerWidth; });
 RenderSystem::RenderSystem() noexcept
 	: mGame(Game::getInstance()), mWindow(nullptr, SDL_DestroyWindow), mCursor(nullptr, SDL_DestroyCursor),
 	  mIcon(nullptr, SDL_DestroySurface), mGL(nullptr), mFramebuffer(nullptr), mMatricesUBO(nullptr),
-	  mTextures(nullptr), mShaders(nullptr), mMesh(nullptr), mWidth(0), mHeight(0) {
+	  mAtlasUBO(nullptr), mFrameUBO(nullptr), mFrameUniforms(), mTextures(nullptr), mShaders(nullptr),
+	  mMesh(nullptr), mSprites(nullptr), mQueue(nullptr), mFrameStats(), mProfiler(nullptr), mSnapshot(),
+	  mHitboxes(false), mWidth(0), mHeight(0) {
 	const SDL_DisplayMode* const DM = SDL_GetCurrentDisplayMode(SDL_GetPrimaryDisplay());
 
 	SDL_Log("\n");
@@ -188,6 +202,11 @@ RenderSystem::RenderSystem() noexcept
 	mTextures = std::make_unique<TextureManager>();
 	mShaders = std::make_unique<ShaderManager>();
 
+	// The simulation can't load textures while a frame is drawn, have the ones of the items ready
+	for (const auto& [_, name] : registers::TEXTURES) {
+		(void)mTextures->get(name);
+	}
+
 	mFramebuffer = std::make_unique<Framebuffer>(this);
 	// NOTE: Uncomment if testing framebuffer module
 	// glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -196,6 +215,15 @@ RenderSystem::RenderSystem() noexcept
 	mMatricesUBO = std::make_unique<UBO>(2 * sizeof(Eigen::Affine3f));
 	mMatricesUBO->bind(0);
 
+	// Texture coordinates of the items in the atlas, for the blocks
+	static_assert(etoi(Components::Item::ITEM_COUNT) <= ATLAS_ITEMS);
+	mAtlasUBO = std::make_unique<UBO>(ATLAS_ITEMS * sizeof(Eigen::Vector4f));
+	mAtlasUBO->bind(1);
+
+	// Camera and time, the same for everything drawn in a frame
+	mFrameUBO = std::make_unique<UBO>(sizeof(FrameUniforms));
+	mFrameUBO->bind(2);
+
 	// Debug Info
 	mGL->printInfo();
 
@@ -212,6 +240,9 @@ RenderSystem::RenderSystem() noexcept
 					 1, 2, 3}; // b
 
 	mMesh.reset(new Mesh(vertices, {}, {}, indices, {}));
+	mSprites = std::make_unique<SpriteBatch>();
+	mQueue = std::make_unique<RenderQueue>();
+	mProfiler = std::make_unique<Profiler>();
 
 #ifndef __ANDROID__
 	std::unique_ptr<SDL_Surface, void (*)(SDL_Surface*)> cursorSurface(
@@ -253,166 +284,150 @@ void RenderSystem::setDemensions(int width, int height) {
  * Hmm maybe fustrum culling & occlusion culling
  */
 
-void RenderSystem::draw(Scene* scene) {
-	// Values *borrowed* from minecraft wiki
-	glClearColor(0.470588235294f, 0.65490190784f, 1.0f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
+void RenderSystem::record(Scene* scene) {
+	mFrameStats = GLState::getStats();
+	GLState::resetStats();
+	mProfiler->frame();
 
-	const Eigen::Vector2f cameraOffset = -scene->get<Components::position>(mGame->getPlayerID()).mPosition +
-					     Eigen::Vector2f(mWidth, mHeight) / 2;
+	mSnapshot.mCamera = -scene->get<Components::position>(mGame->getPlayerID()).mPosition +
+			    Eigen::Vector2f(mWidth, mHeight) / 2;
+	mSnapshot.mTime = ReplayManager::getTicks() / 1000.0f;
 
 	const Eigen::Vector2f screenSize = mGame->getSystemManager()->getDemensions() / Components::block::BLOCK_SIZE;
 	const Eigen::Vector2f playerBlockPos = (scene->get<Components::position>(mGame->getPlayerID()).mPosition +
 						scene->get<Components::collision>(mGame->getPlayerID()).mOffset) /
 					       Components::block::BLOCK_SIZE;
 
-	// Screen top, bottom...
-	const float sb = playerBlockPos.y() - screenSize.y() / 2 - 1;
-	const float st = playerBlockPos.y() + screenSize.y() / 2;
-	const float sl = playerBlockPos.x() - screenSize.x() / 2 - 2;
-	const float sr = playerBlockPos.x() + screenSize.x() / 2;
-
-	// 1. Blitz the new blocks onto our texture atlas
-	Shader* shader = mShaders->get("blitz.vert", "block.frag");
-	shader->activate();
-	const auto blocks = scene->view<Components::block>();
-	for (const auto& [_, block] : blocks.each()) {
-		const auto& pos = block.mPosition;
+	// Screen left and right
+	mSnapshot.mLeft = playerBlockPos.x() - screenSize.x() / 2 - 2;
+	mSnapshot.mRight = playerBlockPos.x() + screenSize.x() / 2;
 
-		// Culling
-		if (!(pos.y() >= sb && pos.y() <= st && pos.x() <= sr && pos.x() >= sl)) {
-			continue;
-		}
+	beginPass(Pass::UPLOAD);
+	applyChunkChanges();
+	updateChunks(scene);
+	updateAtlas();
 
-		mTextures->blitzAtlas(block.mType);
+	// Other textures then the animations over them, batched by texture
+	beginPass(Pass::SPRITES);
+	for (const auto& [entity, texture, position] :
+	     scene->view<Components::texture, Components::position>().each()) {
+		addSprite(texture.mTexture, 0, position.mPosition, texture.mTexture->getSize() * texture.mScale,
+			  Eigen::Vector4f(0.0f, 0.0f, 1.0f, 1.0f));
 	}
 
-	mFramebuffer->bind();
-
-	// Draw blocks
-	shader = mShaders->get("block.vert", "block.frag");
-	shader->activate();
-	shader->set("texture_diffuse"_u, 0);
-	shader->set("offset"_u, cameraOffset);
+	for (const auto& [entity, texture, position] :
+	     scene->view<Components::animated_texture, Components::position>().each()) {
+		Eigen::Vector2f offset = position.mPosition;
 
-	std::vector<GLint> data;
-	for (const auto& [_, block] : blocks.each()) {
-		const auto& pos = block.mPosition;
+		// The item is on screen
+		if (scene->contains<Components::item>(entity)) {
+			offset.y() += 40 * SDL_sin(mSnapshot.mTime + position.mPosition.sum());
+		}
 
-		// Culling
-		if (!(pos.y() >= sb && pos.y() <= st && pos.x() <= sr && pos.x() >= sl)) {
-			continue;
+		// Cell of the sprite sheet
+		const Eigen::Vector2f cell = texture.mSize.cast<float>().cwiseInverse();
+		Eigen::Vector4f uv(cell.x() * (texture.mSelect % texture.mSize.x()),
+				   cell.y() * (texture.mSelect / texture.mSize.x()), cell.x(), cell.y());
+		if (texture.mFlip) {
+			uv.x() += cell.x();
+			uv.z() = -cell.x();
 		}
 
-		data.emplace_back(pos.x());
-		data.emplace_back(pos.y());
-		data.emplace_back(static_cast<GLint>(etoi(block.mType)));
+		addSprite(texture.mSpriteSheet, 1, offset, texture.mSpriteSheet->getSize().cwiseProduct(cell), uv);
 	}
 
-	auto* const atlas = mTextures->getAtlas();
-	atlas->activate(0);
-
-	static bool initialized = false;
-	static unsigned int instanceVBO;
-	if (!initialized) {
-		initialized = true;
-
-		glGenBuffers(1, &instanceVBO);
-		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(GLint) * data.size(), data.data(), GL_STATIC_DRAW);
+	// Queued, drawn over the block breaking with the text
+	beginPass(Pass::HUD);
+	drawHUD(scene);
+	endPass();
 
-		mMesh->addAttribArray(instanceVBO, [] {
-			glEnableVertexAttribArray(3);
-			glVertexAttribIPointer(3, 3, GL_INT, 3 * sizeof(GLint), nullptr);
-			glVertexAttribDivisor(3, 1);
-		});
+#if defined(IMGUI) && !defined(GLES)
+	mSnapshot.mHitboxes.clear();
+	if (scene->getSignal("collisionEditor"_u) || mHitboxes) {
+		for (const auto& [_, collision, position] :
+		     scene->view<Components::collision, Components::position>().each()) {
+			mSnapshot.mHitboxes.emplace_back(position.mPosition + collision.mOffset + mSnapshot.mCamera,
+							 collision.mSize);
+		}
 	}
+#endif
+}
 
-	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLint) * data.size(), data.data(), GL_STATIC_DRAW);
-
-	mMesh->drawInstanced(data.size() / 3);
-
-	// Draw other textures
-	shader = mShaders->get("single_block.vert", "block.frag");
-	shader->activate();
-	shader->set("position"_u, 0, 0);
-	for (const auto& [entity, texture, position] :
-	     scene->view<Components::texture, Components::position>().each()) {
-		Eigen::Vector2f offset = position.mPosition + cameraOffset;
-
-		shader->set("offset"_u, offset);
-		shader->set("scale"_u, texture.mScale);
-
-		texture.mTexture->activate(0);
+void RenderSystem::draw() {
+	// Values *borrowed* from minecraft wiki
+	glClearColor(0.470588235294f, 0.65490190784f, 1.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
 
-		mMesh->draw(shader);
+	const FrameUniforms frame = {mSnapshot.mCamera, mSnapshot.mTime, 0.0f};
+	if (frame.mCamera != mFrameUniforms.mCamera || frame.mTime != mFrameUniforms.mTime) {
+		mFrameUniforms = frame;
+		mFrameUBO->set(0, sizeof(frame), &frame);
 	}
 
-	// Draw animations
-	shader = mShaders->get("animation.vert", "block.frag");
+	mFramebuffer->bind();
+
+	// Draw blocks, a draw per chunk on screen
+	beginPass(Pass::BLOCKS);
+	Shader* shader = mShaders->get("block.vert", "lit_block.frag");
 	shader->activate();
 	shader->set("texture_diffuse"_u, 0);
-	for (const auto& [entity, texture, position] :
-	     scene->view<Components::animated_texture, Components::position>().each()) {
-		Eigen::Vector2f offset = position.mPosition + cameraOffset;
 
-		// Not so performant but let's do it for each entity
-		const float time = SDL_sin(SDL_GetTicks() / 1000.0f + position.mPosition.sum());
+	Texture* const atlas = mTextures->getAtlas();
+	if (atlas != nullptr) {
+		atlas->activate(0);
+	}
 
-		// The item is on screen
-		if (scene->contains<Components::item>(entity)) {
-			offset.y() += 40 * time;
+	for (const auto& [position, mesh] : mChunkMeshes) {
+		const float left = position * Chunk::CHUNK_WIDTH;
+		if (left > mSnapshot.mRight || left + Chunk::CHUNK_WIDTH < mSnapshot.mLeft) {
+			continue;
 		}
 
-		shader->set("offset"_u, offset);
-		shader->set("size"_u, texture.mSize);
-		shader->set("select"_u, texture.mSelect);
-		shader->set("flip"_u, texture.mFlip);
-
-		texture.mSpriteSheet->activate(0);
-
-		mMesh->draw(shader);
+		mesh->draw(mMesh.get());
 	}
 
-	shader = mShaders->get("block.vert", "block.frag");
+	beginPass(Pass::SPRITES);
+	shader = mShaders->get("sprite.vert", "block.frag");
 	shader->activate();
-
-	drawHUD(scene);
+	shader->set("texture_diffuse"_u, 0);
+	mSprites->draw();
+	endPass();
 
 #if defined(IMGUI) && !defined(GLES)
-	static bool hitbox = false;
 	static bool vector = false;
 
 	ImGui::Begin("Developer menu");
-	ImGui::Checkbox("Show hitboxes", &hitbox);
+	ImGui::Checkbox("Show hitboxes", &mHitboxes);
 	ImGui::Checkbox("Show velocity vectors", &vector);
+	ImGui::Text("Draw calls: %zu", mFrameStats.mDrawCalls);
+	ImGui::Text("State changes: %zu (%zu programs, %zu textures, %zu vertex arrays, %zu blends)",
+		    mFrameStats.stateChanges(), mFrameStats.mPrograms, mFrameStats.mTextures,
+		    mFrameStats.mVertexArrays, mFrameStats.mBlends);
+	ImGui::Text("Skipped state changes: %zu", mFrameStats.mSkipped);
 	ImGui::End();
 
 	// Debug layer rendering
-	if (scene->getSignal("collisionEditor"_u) || hitbox) {
+	if (!mSnapshot.mHitboxes.empty()) {
 		GLint mode[2];
-		if (hitbox && glPolygonMode != nullptr) {
+		if (mHitboxes && glPolygonMode != nullptr) {
 			glGetIntegerv(GL_POLYGON_MODE, mode);
 
 			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 		}
 
-		Shader* editorShader = mGame->getSystemManager()->getShader("block.vert", "editor.frag");
+		Shader* editorShader = mGame->getSystemManager()->getShader("ui.vert", "editor.frag");
 
 		editorShader->activate();
-		editorShader->set("wireframe"_u, hitbox);
-
-		for (const auto& [_, collision, position] :
-		     scene->view<Components::collision, Components::position>().each()) {
-			const Eigen::Vector2f offset = position.mPosition + collision.mOffset + cameraOffset;
+		editorShader->set("wireframe"_u, mHitboxes);
 
+		for (const auto& [offset, size] : mSnapshot.mHitboxes) {
 			editorShader->set("offset"_u, offset);
+			editorShader->set("size"_u, size);
 
 			mMesh->draw(editorShader);
 		}
 
-		if (hitbox && glPolygonMode != nullptr) {
+		if (mHitboxes && glPolygonMode != nullptr) {
 			glPolygonMode(GL_FRONT_AND_BACK, mode[0]);
 		}
 	}
@@ -420,6 +435,10 @@ void RenderSystem::draw(Scene* scene) {
 	mShaders->debugGui();
 #endif
 
+#ifdef IMGUI
+	mProfiler->gui();
+#endif
+
 #ifdef __EMSCRIPTEN__
 	// Emscripten, SDL3 doesn't correctly report resize atm
 	if (browserWidth() != mWidth || browserHeight() != mHeight) {
@@ -431,9 +450,171 @@ void RenderSystem::draw(Scene* scene) {
 #endif
 }
 
-void RenderSystem::present() const { mFramebuffer->swap(); }
+void RenderSystem::chunkLoaded(const std::int64_t position) { mChunkChanges.emplace_back(position, true); }
 
-void RenderSystem::swapWindow() const { SDL_GL_SwapWindow(mWindow.get()); }
+void RenderSystem::chunkUnloaded(const std::int64_t position) { mChunkChanges.emplace_back(position, false); }
+
+void RenderSystem::tileChanged(const Eigen::Vector2i& pos) {
+	// The light of a tile reaches MAX_LIGHT tiles away, maybe into a neighbour
+	const std::int64_t left = Chunk::getChunk(pos.x() - LightEngine::MAX_LIGHT);
+	const std::int64_t right = Chunk::getChunk(pos.x() + LightEngine::MAX_LIGHT);
+
+	for (std::int64_t chunk = left; chunk <= right; ++chunk) {
+		markChunk(chunk);
+	}
+}
+
+void RenderSystem::clearChunks() {
+	mChunkMeshes.clear();
+	mChunkChanges.clear();
+	mDirtyChunks.clear();
+}
+
+void RenderSystem::applyChunkChanges() {
+	for (const auto& [position, loaded] : mChunkChanges) {
+		if (!loaded) {
+			mChunkMeshes.erase(position);
+
+			continue;
+		}
+
+		mChunkMeshes.try_emplace(position, std::make_unique<ChunkMesh>());
+
+		// Light flows into the neighbours
+		for (const std::int64_t chunk : {position - 1, position, position + 1}) {
+			markChunk(chunk);
+		}
+	}
+
+	mChunkChanges.clear();
+}
+
+void RenderSystem::markChunk(const std::int64_t position) {
+	if (mChunkMeshes.contains(position) && std::ranges::find(mDirtyChunks, position) == mDirtyChunks.end()) {
+		mDirtyChunks.emplace_back(position);
+	}
+}
+
+void RenderSystem::updateChunks(Scene* scene) {
+	if (mDirtyChunks.empty()) {
+		return;
+	}
+
+	const Level* const level = mGame->getLevel();
+	const auto instance = [level](const Eigen::Vector2i& pos, const Components::Item type) {
+		if (type == Components::AIR()) {
+			return ChunkMesh::Instance{pos.x(), pos.y(), 0, 0};
+		}
+
+		return ChunkMesh::Instance{pos.x(), pos.y(), static_cast<GLint>(etoi(type)), level->getLight(pos)};
+	};
+
+	// The blocks outside of the grids are only in the scene, a single pass for all the chunks
+	mOutsideBlocks.clear();
+	for (const auto& [_, block] : scene->view<Components::block>().each()) {
+		const auto& pos = block.mPosition;
+		if (pos.y() >= 0 && pos.y() < Chunk::MAX_HEIGHT) {
+			continue;
+		}
+
+		if (std::ranges::find(mDirtyChunks, Chunk::getChunk(pos.x())) != mDirtyChunks.end()) {
+			mOutsideBlocks.emplace_back(Chunk::getChunk(pos.x()), instance(pos, block.mType));
+		}
+	}
+
+	for (const std::int64_t position : mDirtyChunks) {
+		const Chunk::Grid* const tiles = level->getTiles(position);
+		if (tiles == nullptr) {
+			continue;
+		}
+
+		// One instance per tile in the same order as the grid, so a changed block only changes its instance
+		mChunkInstances.clear();
+		for (std::size_t i = 0; i < tiles->size(); ++i) {
+			const Eigen::Vector2i pos(position * Chunk::CHUNK_WIDTH + i / Chunk::MAX_HEIGHT,
+						  i % Chunk::MAX_HEIGHT);
+
+			mChunkInstances.emplace_back(instance(pos, (*tiles)[i]));
+		}
+
+		for (const auto& [chunk, outside] : mOutsideBlocks) {
+			if (chunk == position) {
+				mChunkInstances.emplace_back(outside);
+			}
+		}
+
+		mChunkMeshes.at(position)->update(mChunkInstances);
+	}
+
+	mDirtyChunks.clear();
+}
+
+void RenderSystem::updateAtlas() {
+	const TextureManager::Region* const missing = mTextures->getRegion("missing-texture.png");
+
+	std::array<Eigen::Vector4f, ATLAS_ITEMS> rects;
+	rects.fill(missing != nullptr ? missing->mUV : Eigen::Vector4f::Zero());
+
+	// Not constant, a lit furnace changes its texture
+	for (const auto& [item, name] : registers::TEXTURES) {
+		const TextureManager::Region* const region = mTextures->getRegion(name);
+
+		if (region != nullptr && region->mPage == mTextures->getAtlas()) {
+			rects[etoi(item)] = region->mUV;
+		}
+	}
+
+	if (rects != mAtlasRects) {
+		mAtlasRects = rects;
+		mAtlasUBO->set(0, sizeof(rects), rects.data());
+	}
+}
+
+void RenderSystem::addSprite(const Texture* const texture, const int layer, const Eigen::Vector2f& position,
+			     const Eigen::Vector2f& size, const Eigen::Vector4f& uv) {
+	// Draw from the atlas when it's in there, so most sprites end up in the same batch
+	const TextureManager::Region* const region = mTextures->getRegion(texture);
+	if (region == nullptr) {
+		mSprites->add(texture, layer, position, size, uv);
+
+		return;
+	}
+
+	const Eigen::Vector4f& page = region->mUV;
+	mSprites->add(region->mPage, layer, position, size,
+		      Eigen::Vector4f(page.x() + uv.x() * page.z(), page.y() + uv.y() * page.w(), uv.z() * page.z(),
+				      uv.w() * page.w()));
+}
+
+void RenderSystem::flush() {
+	mQueue->flush([this](const RenderQueue::Pass pass) {
+		switch (pass) {
+			case RenderQueue::Pass::HUD:
+				beginPass(Pass::HUD);
+
+				break;
+			case RenderQueue::Pass::TEXT:
+				beginPass(Pass::TEXT);
+
+				break;
+			case RenderQueue::Pass::UI:
+				beginPass(Pass::UI);
+
+				break;
+		}
+	});
+	endPass();
+}
+
+void RenderSystem::present() {
+	beginPass(Pass::PRESENT);
+	mFramebuffer->swap();
+	endPass();
+}
+
+void RenderSystem::beginPass(const Pass pass) { mProfiler->begin(pass); }
+
+void RenderSystem::endPass() { mProfiler->end(); }
 
 Texture* RenderSystem::getTexture(const std::string& name, const bool srgb) { return mTextures->get(name, srgb); }
 
@@ -464,18 +645,11 @@ void RenderSystem::setPersp() const {
 }
 
 void RenderSystem::drawHUD(Scene* scene) {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
 	SystemManager* systemManager = mGame->getSystemManager();
 	Texture* texture = mTextures->get("ui/hotbar.png");
 	Shader* shader = systemManager->getShader("ui.vert", "ui.frag");
 	const Eigen::Vector2f dimensions = systemManager->getDemensions();
 
-	shader->activate();
-	shader->set("texture_diffuse"_u, 0);
-	texture->activate(0);
-
 	float x;
 	float y;
 
@@ -489,10 +663,10 @@ void RenderSystem::drawHUD(Scene* scene) {
 
 	Eigen::Vector2f offset = Eigen::Vector2f((dimensions.x() - x) / 2, 0.0f);
 
-	shader->set("size"_u, x, y);
-	shader->set("offset"_u, offset);
-
-	mMesh->draw(shader);
+	mQueue->submit(RenderQueue::Pass::HUD, HOTBAR, shader, texture, mMesh.get(), true)
+		.set("texture_diffuse"_u, 0)
+		.set("size"_u, x, y)
+		.set("offset"_u, offset);
 
 	// Draw the selection
 	Texture* const selectTexture = systemManager->getTexture("ui/hotbar-selection.png");
@@ -500,16 +674,13 @@ void RenderSystem::drawHUD(Scene* scene) {
 		static_cast<PlayerInventory*>(scene->get<Components::inventory>(mGame->getPlayerID()).mInventory)
 			->getSelection();
 
-	shader->set("size"_u, y, y);
-	shader->set("offset"_u, offset.x() + x / 9.1 * select, 0.0f);
-
-	selectTexture->activate(0);
-
-	mMesh->draw(shader);
+	mQueue->submit(RenderQueue::Pass::HUD, SELECTION, shader, selectTexture, mMesh.get(), true)
+		.set("texture_diffuse"_u, 0)
+		.set("size"_u, y, y)
+		.set("offset"_u, offset.x() + x / 9.1f * select, 0.0f);
 
 	// Draw the items
 	const float size = y / 2;
-	shader->set("size"_u, size, size);
 
 	Inventory* const inventory = scene->get<Components::inventory>(mGame->getPlayerID()).mInventory;
 	for (std::size_t i = 0; i < 9; ++i) {
@@ -518,25 +689,21 @@ void RenderSystem::drawHUD(Scene* scene) {
 		}
 
 		Texture* const itemTexture = mTextures->get(registers::TEXTURES.at(inventory->mItems[i]));
-		itemTexture->activate(0);
-
-		shader->set("offset"_u, offset.x() + i * x / 9.1 + y / 4, y / 4);
 
-		mMesh->draw(shader);
+		mQueue->submit(RenderQueue::Pass::HUD, ITEMS, shader, itemTexture, mMesh.get(), true)
+			.set("texture_diffuse"_u, 0)
+			.set("size"_u, size, size)
+			.set("offset"_u, offset.x() + i * x / 9.1f + y / 4, y / 4);
 
 		if (inventory->mCount[i] > 1) {
 			// Adjust the offset according to number of digits
 			float yoffset = inventory->mCount[i] >= 10 ? (y / 5 * 3) : (y / 4 * 3);
-			mGame->getSystemManager()->getTextSystem()->draw(
-				std::to_string(inventory->mCount[i]),
+			mGame->getSystemManager()->getTextSystem()->submit(
+				mQueue.get(), RenderQueue::Pass::HUD, COUNTS, std::to_string(inventory->mCount[i]),
 				Eigen::Vector2f(offset.x() + i * x / 9 + yoffset, y / 9), false,
 				Eigen::Vector3f(0.9f, 0.9f, 0.9f));
 		}
-
-		shader->activate();
 	}
-
-	glDisable(GL_BLEND);
 }
 
 void RenderSystem::setOrtho() const {
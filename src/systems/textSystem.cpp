@@ -6,9 +6,11 @@
 #include "managers/systemManager.hpp"
 #include "misc/sparse_set_view.hpp"
 #include "opengl/mesh.hpp"
+#include "opengl/renderQueue.hpp"
 #include "opengl/shader.hpp"
 #include "opengl/texture.hpp"
 #include "scene.hpp"
+#include "systems/renderSystem.hpp"
 #include "third_party/Eigen/Core"
 #include "third_party/glad/glad.h"
 #include "third_party/stb_truetype.h"
@@ -93,18 +95,19 @@ void TextSystem::loadFont(const std::string& name) {
 	mGlyphMap.clear();
 }
 
-// Somehow this is taking a ton of time??
-void TextSystem::drawGlyph(const char32_t character, Shader* shader, const Eigen::Vector2f& offset) {
+// A texture per glyph, the queue sorts the same letters together so they share the bind
+void TextSystem::submitGlyph(RenderQueue* queue, const RenderQueue::Pass pass, const int layer,
+			     const char32_t character, Shader* shader, const Eigen::Vector2f& offset,
+			     const Eigen::Vector3f& color) {
 	const TextSystem::Glyph& glyph = getGlyph(character);
 
 	[[unlikely]] if (!glyph.texture) { return; }
 
-	shader->set("offset"_u,
-		    Eigen::Vector2f(offset.x() + glyph.bearing.x(), offset.y() - (glyph.size.y() - glyph.bearing.y())));
-
-	glyph.texture->activate(0);
-
-	mMesh->draw(shader);
+	queue->submit(pass, layer, shader, glyph.texture, mMesh.get(), true)
+		.set("letter"_u, 0)
+		.set("textColor"_u, color)
+		.set("offset"_u, Eigen::Vector2f(offset.x() + glyph.bearing.x(),
+						 offset.y() - (glyph.size.y() - glyph.bearing.y())));
 }
 
 TextSystem::Glyph& TextSystem::getGlyph(const char32_t character) {
@@ -133,10 +136,8 @@ TextSystem::Glyph& TextSystem::getGlyph(const char32_t character) {
 
 void TextSystem::draw(Scene* scene) {
 	Shader* shader = mGame->getSystemManager()->getShader("text.vert", "text.frag");
+	RenderQueue* const queue = mGame->getSystemManager()->getRenderSystem()->getRenderQueue();
 	const Eigen::Vector2f dimensions = mGame->getSystemManager()->getDemensions();
-	shader->activate();
-	shader->set("letter"_u, 0);
-	shader->set("textColor"_u, COLOR);
 
 	for (const auto& [_, text, position] : scene->view<Components::text, Components::position>().each()) {
 		auto offset = position.mPosition;
@@ -178,31 +179,37 @@ void TextSystem::draw(Scene* scene) {
 		}
 
 		for (const auto c : mGame->getLocaleManager()->get(text.mID)) {
-			drawGlyph(c, shader, offset);
+			submitGlyph(queue, RenderQueue::Pass::TEXT, 0, c, shader, offset, COLOR);
 
 			offset += getGlyph(c).advance;
 		}
 	}
 }
 
-void TextSystem::draw(const std::string_view str, const Eigen::Vector2f& o, const bool translate,
+void TextSystem::draw(const std::string_view str, const Eigen::Vector2f& offset, const bool translate,
 		      const Eigen::Vector3f& color) {
+	RenderQueue* const queue = mGame->getSystemManager()->getRenderSystem()->getRenderQueue();
+
+	submit(queue, RenderQueue::Pass::UI, 0, str, offset, translate, color);
+	queue->flush();
+}
+
+void TextSystem::submit(RenderQueue* const queue, const RenderQueue::Pass pass, const int layer,
+			const std::string_view str, const Eigen::Vector2f& o, const bool translate,
+			const Eigen::Vector3f& color) {
 	Shader* shader = mGame->getSystemManager()->getShader("text.vert", "text.frag");
-	shader->activate();
-	shader->set("letter"_u, 0);
-	shader->set("textColor"_u, color);
 
 	Eigen::Vector2f offset = o;
 
 	if (translate) {
 		for (const auto c : mGame->getLocaleManager()->get(str)) {
-			drawGlyph(c, shader, offset);
+			submitGlyph(queue, pass, layer, c, shader, offset, color);
 
 			offset += getGlyph(c).advance;
 		}
 	} else {
 		for (const auto c : str) {
-			drawGlyph(c, shader, offset);
+			submitGlyph(queue, pass, layer, c, shader, offset, color);
 
 			offset += getGlyph(c).advance;
 		}
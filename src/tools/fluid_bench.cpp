@@ -0,0 +1,94 @@
+// Fluid simulation benchmark
+// Digs a cave under a lake with holes in its floor and steps the water until everything settles
+//
+// Usage: fluid_bench [chunks] [max ticks]
+#include "items.hpp"
+#include "registers.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/fluidSimulation.hpp"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char** argv) {
+	const std::int64_t chunks = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 8;
+	const std::uint64_t maxTicks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+	if (chunks <= 0 || maxTicks == 0) {
+		std::fprintf(stderr, "Usage: %s [chunks] [max ticks]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	// Stone walls all around, the cave and the lake on top, the floor of the lake gets holes every HOLES columns
+	constexpr const int CAVE_BOTTOM = 2;
+	constexpr const int CAVE_TOP = 90;
+	constexpr const int LAKE_BOTTOM = 92;
+	constexpr const int LAKE_TOP = 110;
+	constexpr const int HOLES = 12;
+	const std::int64_t width = chunks * Chunk::CHUNK_WIDTH;
+
+	FluidSimulation fluids;
+
+	for (std::int64_t position = 0; position < chunks; ++position) {
+		Chunk::Grid tiles;
+		tiles.fill(Components::Item::STONE);
+
+		for (int x = 0; x < Chunk::CHUNK_WIDTH; ++x) {
+			const std::int64_t worldX = position * Chunk::CHUNK_WIDTH + x;
+			if (worldX == 0 || worldX == width - 1) {
+				continue;
+			}
+
+			for (int y = CAVE_BOTTOM; y < CAVE_TOP; ++y) {
+				tiles[x * Chunk::MAX_HEIGHT + y] = Components::AIR();
+			}
+
+			for (int y = LAKE_BOTTOM; y < LAKE_TOP; ++y) {
+				tiles[x * Chunk::MAX_HEIGHT + y] = Components::Item::WATER;
+			}
+		}
+
+		fluids.addChunk(position, tiles);
+	}
+
+	// Break the floor of the lake
+	for (std::int64_t x = HOLES / 2; x < width - 1; x += HOLES) {
+		for (int y = CAVE_TOP; y < LAKE_BOTTOM; ++y) {
+			fluids.setTile(Eigen::Vector2i(x, y), Components::AIR());
+		}
+	}
+
+	std::vector<std::uint64_t> times;
+	std::uint64_t changes = 0;
+	std::uint64_t peak = 0;
+	std::uint64_t tick = 1;
+
+	const std::uint64_t start = SDL_GetTicksNS();
+	for (; tick <= maxTicks && fluids.getActive() != 0; ++tick) {
+		peak = std::max<std::uint64_t>(peak, fluids.getActive());
+
+		const std::uint64_t before = SDL_GetTicksNS();
+		fluids.tick(tick);
+		times.emplace_back(SDL_GetTicksNS() - before);
+
+		changes += fluids.getChanges().size();
+	}
+	const std::uint64_t total = SDL_GetTicksNS() - start;
+
+	std::sort(times.begin(), times.end());
+
+	std::printf("%s after %" PRIu64 " ticks, %" PRIu64 " tile changes, peak of %" PRIu64 " active cells\n",
+		    fluids.getActive() == 0 ? "settled" : "still flowing", tick - 1, changes, peak);
+	std::printf("total %.2f ms, tick p50 %.2f us, p99 %.2f us, max %.2f us\n", total / 1e6,
+		    times[times.size() / 2] / 1000.0, times[static_cast<std::uint64_t>(0.99 * (times.size() - 1))] / 1000.0,
+		    times.back() / 1000.0);
+	std::printf("floor level at x = 1: %d\n", fluids.getLevel(Eigen::Vector2i(1, CAVE_BOTTOM)));
+
+	return fluids.getActive() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+// Integration benchmark
+// Drops bodies on a flat floor and times stepping them one by one against stepping the packed columns
+//
+// Usage: integration_bench [steps] [bodies...]
+#include "misc/integration.hpp"
+#include "third_party/Eigen/Core"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr const float G = 1200.0f;
+constexpr const float FRICTION = 0.7f;
+constexpr const float DELTA = 1.0f / 60.0f;
+
+struct Body {
+	Eigen::Vector2f mPosition;
+	Eigen::Vector2f mVelocity;
+	bool mGrounded;
+};
+
+// The way the physics used to step, body after body
+void stepBodies(std::vector<Body>& bodies) {
+	for (auto& body : bodies) {
+		if (!body.mGrounded) {
+			body.mVelocity.y() -= G * DELTA;
+		}
+
+		body.mPosition += body.mVelocity * DELTA;
+		body.mVelocity.x() *= FRICTION;
+
+		if (body.mPosition.y() <= 0.0f) {
+			body.mPosition.y() = 0.0f;
+			body.mVelocity.y() = 0.0f;
+			body.mGrounded = true;
+		}
+	}
+}
+
+void stepColumns(integration::Columns& columns) {
+	integration::gravity(columns, G, DELTA);
+	integration::move(columns, DELTA);
+	integration::friction(columns, FRICTION);
+
+	// The floor, as column operations too
+	const Eigen::Index size = columns.mSize;
+	const auto landed = (columns.mPositionY.head(size) <= 0.0f).cast<float>();
+	columns.mGrounded.head(size) = columns.mGrounded.head(size).max(landed);
+	columns.mVelocityY.head(size) *= 1.0f - landed;
+	columns.mPositionY.head(size) = columns.mPositionY.head(size).max(0.0f);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	const std::uint64_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300;
+	std::vector<std::uint64_t> counts;
+	for (int i = 2; i < argc; ++i) {
+		counts.emplace_back(std::strtoull(argv[i], nullptr, 10));
+	}
+
+	if (counts.empty()) {
+		counts = {10000, 30000, 100000};
+	}
+
+	if (steps == 0) {
+		std::fprintf(stderr, "Usage: %s [steps] [bodies...]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	bool same = true;
+	for (const auto count : counts) {
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> height(0.0f, 20000.0f);
+		std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+
+		std::vector<Body> bodies;
+		bodies.reserve(count);
+		integration::Columns columns;
+		columns.resize(static_cast<Eigen::Index>(count));
+
+		for (std::uint64_t i = 0; i < count; ++i) {
+			const Body body{Eigen::Vector2f(0.0f, height(random)), Eigen::Vector2f(speed(random), speed(random)),
+					false};
+			bodies.emplace_back(body);
+
+			columns.mPositionX[i] = body.mPosition.x();
+			columns.mPositionY[i] = body.mPosition.y();
+			columns.mVelocityX[i] = body.mVelocity.x();
+			columns.mVelocityY[i] = body.mVelocity.y();
+			columns.mGrounded[i] = 0.0f;
+		}
+
+		std::uint64_t start = SDL_GetTicksNS();
+		for (std::uint64_t i = 0; i < steps; ++i) {
+			stepBodies(bodies);
+		}
+		const std::uint64_t bodyTime = SDL_GetTicksNS() - start;
+
+		start = SDL_GetTicksNS();
+		for (std::uint64_t i = 0; i < steps; ++i) {
+			stepColumns(columns);
+		}
+		const std::uint64_t columnTime = SDL_GetTicksNS() - start;
+
+		// Both ways have to land the bodies at the same place
+		float error = 0.0f;
+		for (std::uint64_t i = 0; i < count; ++i) {
+			error = std::max(error, std::abs(bodies[i].mPosition.y() - columns.mPositionY[i]));
+			error = std::max(error, std::abs(bodies[i].mPosition.x() - columns.mPositionX[i]));
+		}
+		same = same && error < 0.01f;
+
+		std::printf("%7" PRIu64 " bodies: per body %8.2f ms (%5.2f ns/body), columns %8.2f ms (%5.2f ns/body), "
+			    "%.2fx, max difference %g\n",
+			    count, bodyTime / 1e6, static_cast<double>(bodyTime) / (count * steps), columnTime / 1e6,
+			    static_cast<double>(columnTime) / (count * steps),
+			    static_cast<double>(bodyTime) / static_cast<double>(columnTime), error);
+	}
+
+	return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+// Light update benchmark
+// Fills a few chunks with stone, carves a cave in them and measures placing and breaking a torch in it
+//
+// Usage: light_bench [updates] [chunks]
+#include "items.hpp"
+#include "registers.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/lightEngine.hpp"
+#include "third_party/Eigen/Core"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+void report(const char* const name, std::vector<std::uint64_t>& times) {
+	std::sort(times.begin(), times.end());
+
+	std::uint64_t total = 0;
+	for (const auto time : times) {
+		total += time;
+	}
+
+	std::printf("%s: avg %.2f us, p50 %.2f us, p99 %.2f us\n", name, total / 1000.0 / times.size(),
+		    times[times.size() / 2] / 1000.0, times[static_cast<std::uint64_t>(0.99 * (times.size() - 1))] / 1000.0);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	const std::uint64_t updates = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+	const std::int64_t chunks = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 3;
+
+	if (updates == 0 || chunks <= 0) {
+		std::fprintf(stderr, "Usage: %s [updates] [chunks]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	// Solid stone up to the surface, with a cave with some pillars in the middle
+	constexpr const int SURFACE = Chunk::WATER_LEVEL * 2;
+	constexpr const int CAVE_BOTTOM = 4;
+	constexpr const int CAVE_TOP = SURFACE - 6;
+
+	LightEngine light;
+	const std::uint64_t start = SDL_GetTicksNS();
+
+	for (std::int64_t position = 0; position < chunks; ++position) {
+		Chunk::Grid tiles;
+		tiles.fill(Components::AIR());
+
+		for (int x = 0; x < Chunk::CHUNK_WIDTH; ++x) {
+			for (int y = 0; y < SURFACE; ++y) {
+				const bool cave = y >= CAVE_BOTTOM && y < CAVE_TOP && (x + position * Chunk::CHUNK_WIDTH) % 7 != 0;
+
+				tiles[x * Chunk::MAX_HEIGHT + y] = cave ? Components::AIR() : Components::Item::STONE;
+			}
+		}
+
+		light.addChunk(position, tiles);
+	}
+
+	std::printf("lit %" PRIi64 " chunks in %.2f ms\n", chunks, (SDL_GetTicksNS() - start) / 1e6);
+
+	// Stay off the pillars
+	Eigen::Vector2i torch(chunks * Chunk::CHUNK_WIDTH / 2, (CAVE_BOTTOM + CAVE_TOP) / 2);
+	if (torch.x() % 7 == 0) {
+		++torch.x();
+	}
+
+	std::vector<std::uint64_t> placeTimes;
+	std::vector<std::uint64_t> breakTimes;
+	placeTimes.reserve(updates);
+	breakTimes.reserve(updates);
+
+	for (std::uint64_t i = 0; i < updates; ++i) {
+		std::uint64_t before = SDL_GetTicksNS();
+		light.setTile(torch, Components::Item::TORCH);
+		placeTimes.emplace_back(SDL_GetTicksNS() - before);
+
+		before = SDL_GetTicksNS();
+		light.setTile(torch, Components::AIR());
+		breakTimes.emplace_back(SDL_GetTicksNS() - before);
+	}
+
+	std::printf("torch light %d at (%d, %d), %" PRIu64 " updates\n",
+		    registers::LIGHT_LEVELS.at(Components::Item::TORCH), torch.x(), torch.y(), updates);
+	report("place", placeTimes);
+	report("break", breakTimes);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,243 @@
+// Physics stress benchmark
+// Builds a flat world over the three loaded chunks, drops items and walkers on it and runs the physics for a number of
+// ticks while blocks get broken and placed back under them. Prints ticks/sec, the time of every phase, the
+// allocations per tick and a hash of where everything ended up
+//
+// Usage: physics_bench [items] [walkers] [ticks]
+#include "components.hpp"
+#include "items.hpp"
+#include "scene.hpp"
+#include "scenes/chunk.hpp"
+#include "systems/physicsSystem.hpp"
+#include "third_party/Eigen/Core"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+std::uint64_t allocations = 0;
+std::uint64_t tick = 0;
+
+constexpr const float DELTA = 1.0f / 60.0f;
+constexpr const int GROUND = 8;
+constexpr const std::int64_t LEFT = -Chunk::CHUNK_WIDTH;
+constexpr const std::int64_t RIGHT = 2 * Chunk::CHUNK_WIDTH;
+constexpr const std::array<Components::Item, 4> ITEMS = {Components::Item::STONE, Components::Item::DIRT,
+							  Components::Item::GRASS_BLOCK, Components::Item::COBBLESTONE};
+
+EntityID spawnBlock(Scene& scene, const Eigen::Vector2i& pos) {
+	const EntityID block = scene.newEntity();
+	scene.emplace<Components::block>(block, Components::Item::STONE, pos);
+	scene.emplace<Components::collision>(
+		block, Eigen::Vector2f(0.0f, 0.0f),
+		Eigen::Vector2f(Components::block::BLOCK_SIZE, Components::block::BLOCK_SIZE), true);
+
+	return block;
+}
+
+
+struct Phase {
+	const char* mName;
+	std::vector<std::uint64_t> mTimes;
+
+	void report(const std::uint64_t ticks) {
+		std::sort(mTimes.begin(), mTimes.end());
+
+		std::uint64_t total = 0;
+		for (const auto time : mTimes) {
+			total += time;
+		}
+
+		std::printf("%-8s avg %9.2f us, p50 %9.2f us, p99 %9.2f us, %5.1f%% of a tick\n", mName,
+			    total / 1000.0 / ticks, mTimes[mTimes.size() / 2] / 1000.0,
+			    mTimes[static_cast<std::size_t>(0.99 * (mTimes.size() - 1))] / 1000.0,
+			    100.0 * total / ticks / (DELTA * 1e9));
+	}
+};
+
+template <typename Func> void time(Phase& phase, Func func) {
+	const std::uint64_t start = SDL_GetTicksNS();
+	func();
+	phase.mTimes.emplace_back(SDL_GetTicksNS() - start);
+}
+} // namespace
+
+void* operator new(const std::size_t size) {
+	++allocations;
+
+	if (void* const memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* const memory) noexcept { std::free(memory); }
+void operator delete(void* const memory, const std::size_t) noexcept { std::free(memory); }
+
+int main(int argc, char** argv) {
+	const std::uint64_t itemCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+	const std::uint64_t walkerCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+	const std::uint64_t ticks = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1200;
+
+	if (ticks == 0) {
+		std::fprintf(stderr, "Usage: %s [items] [walkers] [ticks]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	Scene scene;
+	PhysicsSystem physics;
+	physics.setCenter(0);
+
+	// Entity 0 can't be erased
+	(void)scene.newEntity();
+
+	// Flat ground with a wall at both ends
+	std::vector<std::pair<Eigen::Vector2i, EntityID>> surface;
+	for (std::int64_t x = LEFT; x < RIGHT; ++x) {
+		const int height = x == LEFT || x == RIGHT - 1 ? GROUND + 6 : GROUND;
+
+		for (int y = 0; y < height; ++y) {
+			const EntityID block = spawnBlock(scene, Eigen::Vector2i(x, y));
+
+			if (y == GROUND - 1) {
+				surface.emplace_back(Eigen::Vector2i(x, y), block);
+			}
+		}
+	}
+	scene.getSignal(PhysicsSystem::PHYSICS_DIRTY_SIGNAL) = true;
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> x((LEFT + 2) * Components::block::BLOCK_SIZE,
+						(RIGHT - 2) * Components::block::BLOCK_SIZE);
+	std::uniform_real_distribution<float> y((GROUND + 1) * Components::block::BLOCK_SIZE,
+						(GROUND + 20) * Components::block::BLOCK_SIZE);
+	std::uniform_real_distribution<float> speed(-200.0f, 200.0f);
+
+	for (std::uint64_t i = 0; i < walkerCount; ++i) {
+		const EntityID walker = scene.newEntity();
+		scene.emplace<Components::position>(walker, Eigen::Vector2f(x(random), y(random)));
+		scene.emplace<Components::velocity>(walker, Eigen::Vector2f(0.0f, 0.0f));
+		scene.emplace<Components::collision>(
+			walker, Eigen::Vector2f(28.0f, 0.0f),
+			Eigen::Vector2f(Components::block::BLOCK_SIZE - 56.0f, Components::block::BLOCK_SIZE));
+		scene.emplace<Components::misc>(walker, Components::misc::JUMP);
+	}
+
+	for (std::uint64_t i = 0; i < itemCount; ++i) {
+		const EntityID item = scene.newEntity();
+		scene.emplace<Components::position>(item, Eigen::Vector2f(x(random), y(random)));
+		scene.emplace<Components::velocity>(item, Eigen::Vector2f(speed(random), speed(random)));
+		scene.emplace<Components::collision>(
+			item, Eigen::Vector2f(0.0f, 0.0f),
+			Eigen::Vector2f(Components::block::BLOCK_SIZE, Components::block::BLOCK_SIZE) * 0.3f);
+		scene.emplace<Components::item>(item, ITEMS[random() % ITEMS.size()]);
+	}
+
+	// Walkers jump whenever they can
+	scene.getSignal(SDL_SCANCODE_SPACE) = true;
+
+	Phase events{"events", {}};
+	Phase input{"input", {}};
+	Phase update{"update", {}};
+	Phase collide{"collide", {}};
+	for (Phase* const phase : {&events, &input, &update, &collide}) {
+		phase->mTimes.reserve(ticks);
+	}
+
+	std::vector<std::uint64_t> allocationCounts;
+	allocationCounts.reserve(ticks);
+
+	const std::uint64_t start = SDL_GetTicksNS();
+	for (tick = 0; tick < ticks; ++tick) {
+		const std::uint64_t before = allocations;
+
+		// Break a block of the surface every few ticks, and put it back a bit later
+		time(events, [&]() {
+			if (tick % 10 != 0) {
+				return;
+			}
+
+			auto& [pos, block] = surface[random() % surface.size()];
+			if (block == MAX_ENTITIES) {
+				block = spawnBlock(scene, pos);
+			} else {
+				scene.erase(block);
+				block = MAX_ENTITIES;
+			}
+
+			physics.tileChanged(pos);
+		});
+
+		// Walk one way for two seconds, then the other
+		time(input, [&]() {
+			for (const auto walker : scene.view<Components::misc>()) {
+				physics.wake(&scene, walker);
+				scene.get<Components::velocity>(walker).mVelocity.x() =
+					(tick / 120 + walker) % 2 == 0 ? 340.0f : -340.0f;
+			}
+		});
+
+		time(update, [&]() { physics.update(&scene, DELTA); });
+		time(collide, [&]() { physics.collide(&scene); });
+
+		allocationCounts.emplace_back(allocations - before);
+	}
+	const std::uint64_t total = SDL_GetTicksNS() - start;
+
+	std::uint64_t items = 0;
+	std::uint64_t stacked = 0;
+	for (const auto& [entity, item] : scene.view<Components::item>().each()) {
+		++items;
+		stacked += item.mCount;
+	}
+
+	std::uint64_t moving = 0;
+	for ([[maybe_unused]] const auto entity : scene.view<Components::velocity>()) {
+		++moving;
+	}
+
+	// Same build and arguments have to end on the same hash, whatever the thread count
+	std::uint64_t hash = 14695981039346656037ull;
+	for (const auto& [entity, position] : scene.view<Components::position>().each()) {
+		for (const float value : {position.mPosition.x(), position.mPosition.y()}) {
+			hash = (hash ^ (entity << 32 | std::bit_cast<std::uint32_t>(value))) * 1099511628211ull;
+		}
+	}
+
+	std::uint64_t sleeping = 0;
+	for ([[maybe_unused]] const auto entity : scene.view<Components::sleeping>()) {
+		++sleeping;
+	}
+
+	std::printf("%" PRIu64 " items, %" PRIu64 " walkers, %" PRIu64 " ticks: %.1f ticks/sec\n", itemCount,
+		    walkerCount, ticks, ticks / (total / 1e9));
+	for (Phase* const phase : {&events, &input, &update, &collide}) {
+		phase->report(ticks);
+	}
+
+	std::sort(allocationCounts.begin(), allocationCounts.end());
+	std::uint64_t allocated = 0;
+	for (const auto count : allocationCounts) {
+		allocated += count;
+	}
+	std::printf("allocations per tick: avg %.1f, p50 %" PRIu64 ", max %" PRIu64 "\n",
+		    static_cast<double>(allocated) / ticks, allocationCounts[allocationCounts.size() / 2],
+		    allocationCounts.back());
+	std::printf("end: %" PRIu64 " item entities holding %" PRIu64 " items, %" PRIu64 " moving, %" PRIu64
+		    " sleeping, positions %016" PRIx64 "\n",
+		    items, stacked, moving, sleeping, hash);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+// Offscreen rendering test
+// Renders a few fixed views of a seeded level without a screen, reads back the framebuffer and compares it against
+// the golden images in the given directory, --update writes them instead. A missing golden image fails the test.
+// The frame that didn't match is written next to the golden one as <view>.actual.ppm. Prints the CPU and GPU time of
+// every pass and writes them frame by frame to profile.csv in the directory
+//
+// Usage: render_test <golden dir> [--update]
+#include "components.hpp"
+#include "game.hpp"
+#include "managers/systemManager.hpp"
+#include "opengl/framebuffer.hpp"
+#include "opengl/profiler.hpp"
+#include "scene.hpp"
+#include "scenes/chunk.hpp"
+#include "scenes/level.hpp"
+#include "systems/renderSystem.hpp"
+#include "third_party/Eigen/Core"
+#include "third_party/stb_image.h"
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr const std::uint64_t SEED = 1234;
+// Frames drawn before the readback, the first one builds the chunk meshes
+constexpr const int WARMUP = 3;
+// Frames drawn to time the passes
+constexpr const int FRAMES = 120;
+// Drivers round differently, a channel can be off by this much
+constexpr const int TOLERANCE = 8;
+// Fraction of the pixels that can be off by more than that
+constexpr const double MAX_DIFFERENT = 0.001;
+
+struct View {
+	const char* mName;
+	// Moved from the spawn, in blocks
+	Eigen::Vector2f mOffset;
+};
+
+const std::array<View, 3> VIEWS = {
+	View{"spawn", Eigen::Vector2f(0.0f, 0.0f)},
+	View{"underground", Eigen::Vector2f(0.0f, -24.0f)},
+	View{"east", Eigen::Vector2f(Chunk::CHUNK_WIDTH, 0.0f)},
+};
+
+bool writeImage(const std::string& path, const std::vector<std::uint8_t>& pixels, const int width, const int height) {
+	std::FILE* const file = std::fopen(path.data(), "wb");
+	if (file == nullptr) {
+		std::fprintf(stderr, "Failed to open %s\n", path.data());
+
+		return false;
+	}
+
+	// Binary PPM, stb_image reads it back
+	std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+	for (std::size_t i = 0; i < pixels.size(); i += 4) {
+		std::fwrite(&pixels[i], 1, 3, file);
+	}
+
+	return std::fclose(file) == 0;
+}
+
+// Fraction of the pixels further off than the tolerance, 1 if the sizes don't match
+double compare(const std::vector<std::uint8_t>& pixels, const int width, const int height,
+	       const std::string& path) {
+	int goldenWidth, goldenHeight, channels;
+	stbi_uc* const golden = stbi_load(path.data(), &goldenWidth, &goldenHeight, &channels, 4);
+	if (golden == nullptr || goldenWidth != width || goldenHeight != height) {
+		std::fprintf(stderr, "%s: %s\n", path.data(),
+			     golden == nullptr ? stbi_failure_reason() : "size doesn't match the framebuffer");
+		stbi_image_free(golden);
+
+		return 1.0;
+	}
+
+	std::size_t different = 0;
+	for (std::size_t i = 0; i < pixels.size(); i += 4) {
+		for (std::size_t c = 0; c < 3; ++c) {
+			if (std::abs(pixels[i + c] - golden[i + c]) > TOLERANCE) {
+				++different;
+
+				break;
+			}
+		}
+	}
+
+	stbi_image_free(golden);
+
+	return static_cast<double>(different) / (static_cast<std::size_t>(width) * height);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "Usage: %s <golden dir> [--update]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	const std::string directory = std::string(argv[1]) + "/";
+	const bool update = argc > 2 && std::strcmp(argv[2], "--update") == 0;
+
+	// A window without a screen, GL goes through EGL pbuffers
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+	if (!SDL_Init(SDL_INIT_VIDEO)) {
+		std::fprintf(stderr, "Failed to init SDL: %s\n", SDL_GetError());
+
+		return EXIT_FAILURE;
+	}
+
+	if (!SDL_CreateDirectory(argv[1])) {
+		std::fprintf(stderr, "Failed to create %s: %s\n", argv[1], SDL_GetError());
+
+		return EXIT_FAILURE;
+	}
+
+	Game* const game = Game::getInstance();
+	game->initHeadless(SEED);
+
+	SystemManager* const systemManager = game->getSystemManager();
+	RenderSystem* const renderSystem = systemManager->getRenderSystem();
+	Framebuffer* const framebuffer = renderSystem->getFramebuffer();
+	Profiler* const profiler = renderSystem->getProfiler();
+	Scene* const scene = game->getLevel()->getScene();
+
+	const Eigen::Vector2f spawn = scene->get<Components::position>(game->getPlayerID()).mPosition;
+
+	bool failed = false;
+	Profiler::Times cpu = {};
+	Profiler::Times gpu = {};
+	int timed = 0;
+	for (const View& view : VIEWS) {
+		scene->get<Components::position>(game->getPlayerID()).mPosition =
+			spawn + view.mOffset * Components::block::BLOCK_SIZE;
+		// Loads the chunks around the new position
+		game->getLevel()->update(0.0f);
+
+		for (int i = 0; i < WARMUP; ++i) {
+			systemManager->update(scene, 0.0f, 0.0f);
+		}
+
+		const std::vector<std::uint8_t> pixels = framebuffer->read();
+		const int width = framebuffer->getWidth();
+		const int height = framebuffer->getHeight();
+		const std::string golden = directory + view.mName + ".ppm";
+
+		if (update) {
+			if (!writeImage(golden, pixels, width, height)) {
+				failed = true;
+			}
+
+			std::printf("%-12s wrote %s\n", view.mName, golden.data());
+		} else if (!SDL_GetPathInfo(golden.data(), nullptr)) {
+			// Passing without anything to compare against would hide a broken renderer
+			failed = true;
+
+			writeImage(directory + view.mName + ".actual.ppm", pixels, width, height);
+			std::printf("%-12s FAILED, %s is missing, run with --update to write it\n", view.mName, golden.data());
+		} else {
+			const double different = compare(pixels, width, height, golden);
+
+			if (different > MAX_DIFFERENT) {
+				failed = true;
+
+				writeImage(directory + view.mName + ".actual.ppm", pixels, width, height);
+			}
+
+			std::printf("%-12s %s, %.3f%% of the pixels differ\n", view.mName,
+				    different > MAX_DIFFERENT ? "FAILED" : "ok", different * 100);
+		}
+
+		// The CPU times are of the frame before the last update, the GPU ones a few frames older
+		for (int i = 0; i < FRAMES; ++i) {
+			systemManager->update(scene, 0.0f, 0.0f);
+
+			for (std::size_t pass = 0; pass < Profiler::PASSES; ++pass) {
+				cpu[pass] += profiler->getCPUTimes()[pass];
+				gpu[pass] += profiler->getGPUTimes()[pass];
+			}
+			++timed;
+		}
+	}
+
+	std::printf("\n%-12s %12s %12s\n", "Per frame", "CPU", "GPU");
+	for (std::size_t pass = 0; pass < Profiler::PASSES; ++pass) {
+		std::printf("%-12s %9.2f us", Profiler::getName(static_cast<Profiler::Pass>(pass)),
+			    cpu[pass] / 1000.0 / timed);
+
+		if (profiler->hasGPUTimes()) {
+			std::printf(" %9.2f us\n", gpu[pass] / 1000.0 / timed);
+		} else {
+			std::printf(" %12s\n", "n/a");
+		}
+	}
+
+	if (!profiler->save(directory + "profile.csv")) {
+		failed = true;
+	}
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+// Swept collision benchmark
+// Throws boxes at thin floors and walls with long frames and checks that nothing goes through, then times the sweep
+// against moving the boxes and pushing them out of what they overlap afterwards
+//
+// Usage: sweep_bench [entities] [steps]
+#include "misc/sweep.hpp"
+#include "third_party/Eigen/Core"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr const float TILE = 112.0f;
+constexpr const float G = 1200.0f;
+
+// Full tiles, everything outside is empty
+struct Grid {
+	std::int64_t mWidth;
+	std::int64_t mHeight;
+	std::vector<bool> mSolid;
+
+	[[nodiscard]] bool solid(const std::int64_t x, const std::int64_t y) const {
+		return x >= 0 && x < mWidth && y >= 0 && y < mHeight && mSolid[x * mHeight + y];
+	}
+
+	void operator()(const std::int64_t x, const std::int64_t y, const auto& visit) const {
+		if (solid(x, y)) {
+			visit(Eigen::Vector2f(x * TILE, y * TILE), Eigen::Vector2f((x + 1) * TILE, (y + 1) * TILE));
+		}
+	}
+};
+
+struct Body {
+	Eigen::Vector2f mPosition;
+	Eigen::Vector2f mVelocity;
+};
+
+const Eigen::Vector2f SIZE(60.0f, 100.0f);
+
+void sweepStep(const Grid& grid, Body& body, const float delta) {
+	const auto result = sweep::move(body.mPosition, SIZE, body.mVelocity * delta, TILE, grid);
+
+	body.mPosition = result.mPosition;
+	if (result.mHitX) {
+		body.mVelocity.x() = 0.0f;
+	}
+
+	if (result.mHitY) {
+		body.mVelocity.y() = 0.0f;
+	}
+}
+
+// What the physics did before, move and push out of the overlapped tiles on the shallow axis
+void discreteStep(const Grid& grid, Body& body, const float delta) {
+	body.mPosition += body.mVelocity * delta;
+
+	const Eigen::Vector2f max = body.mPosition + SIZE;
+	for (auto x = static_cast<std::int64_t>(std::floor(body.mPosition.x() / TILE)); x * TILE < max.x(); ++x) {
+		for (auto y = static_cast<std::int64_t>(std::floor(body.mPosition.y() / TILE)); y * TILE < max.y(); ++y) {
+			if (!grid.solid(x, y)) {
+				continue;
+			}
+
+			const Eigen::Vector2f distance =
+				body.mPosition + SIZE / 2 - Eigen::Vector2f((x + 0.5f) * TILE, (y + 0.5f) * TILE);
+			const Eigen::Vector2f minDistance = (SIZE + Eigen::Vector2f(TILE, TILE)) / 2;
+			if (std::abs(distance.x()) >= minDistance.x() || std::abs(distance.y()) >= minDistance.y()) {
+				continue;
+			}
+
+			const float depthX = (distance.x() > 0 ? minDistance.x() : -minDistance.x()) - distance.x();
+			const float depthY = (distance.y() > 0 ? minDistance.y() : -minDistance.y()) - distance.y();
+			if (std::abs(depthX) <= std::abs(depthY)) {
+				body.mPosition.x() += depthX;
+				body.mVelocity.x() = 0.0f;
+			} else {
+				body.mPosition.y() += depthY;
+				body.mVelocity.y() = 0.0f;
+			}
+		}
+	}
+}
+
+Grid makeGrid(const std::int64_t width, const std::int64_t height) {
+	return Grid{width, height, std::vector<bool>(width * height, false)};
+}
+
+struct Case {
+	const char* mName;
+	Grid mGrid;
+	Body mBody;
+	float mDelta;
+	int mSteps;
+	// The box has to end up on this side of the line
+	int mAxis;
+	float mLimit;
+	bool mBelow;
+};
+
+bool check(const Case& test, const Eigen::Vector2f& position) {
+	const float edge = test.mBelow ? position[test.mAxis] + SIZE[test.mAxis] : position[test.mAxis];
+
+	return test.mBelow ? edge <= test.mLimit + sweep::EPSILON : edge >= test.mLimit - sweep::EPSILON;
+}
+
+std::vector<Case> makeCases() {
+	std::vector<Case> cases;
+
+	// A one tile thick floor at y = 2, falling from high up at 6000 px/s on a 100 ms frame
+	{
+		Grid grid = makeGrid(8, 16);
+		for (std::int64_t x = 0; x < 8; ++x) {
+			grid.mSolid[x * 16 + 2] = true;
+		}
+
+		cases.emplace_back("fast fall on a thin floor", grid,
+				   Body{Eigen::Vector2f(3 * TILE, 12 * TILE), Eigen::Vector2f(0.0f, -6000.0f)}, 0.1f, 20, 1,
+				   3 * TILE, false);
+		cases.emplace_back("lag spike fall", grid,
+				   Body{Eigen::Vector2f(3 * TILE, 14 * TILE), Eigen::Vector2f(0.0f, -200.0f)}, 1.0f, 5, 1,
+				   3 * TILE, false);
+	}
+
+	// A one tile wide wall at x = 6, running into it
+	{
+		Grid grid = makeGrid(16, 8);
+		for (std::int64_t y = 0; y < 8; ++y) {
+			grid.mSolid[6 * 8 + y] = true;
+		}
+
+		cases.emplace_back("sprint into a thin wall", grid,
+				   Body{Eigen::Vector2f(1 * TILE, 3 * TILE), Eigen::Vector2f(8000.0f, 0.0f)}, 0.1f, 10, 0,
+				   6 * TILE, true);
+		cases.emplace_back("diagonal into a thin wall", grid,
+				   Body{Eigen::Vector2f(1 * TILE, 6 * TILE), Eigen::Vector2f(5000.0f, -3000.0f)}, 0.1f, 10, 0,
+				   6 * TILE, true);
+	}
+
+	return cases;
+}
+
+template <typename Step> bool runCases(const char* const name, const std::vector<Case>& cases, Step step) {
+	bool passed = true;
+
+	for (const auto& test : cases) {
+		Body body = test.mBody;
+		for (int i = 0; i < test.mSteps; ++i) {
+			// Keep pushing down after landing, resting on the floor has to hold too
+			if (test.mAxis == 1) {
+				body.mVelocity.y() = std::min(body.mVelocity.y(), test.mBody.mVelocity.y());
+			}
+
+			step(test.mGrid, body, test.mDelta);
+		}
+
+		const bool ok = check(test, body.mPosition);
+		passed = passed && ok;
+
+		std::printf("%s %-28s %s (%.1f, %.1f)\n", name, test.mName, ok ? "ok      " : "TUNNELED",
+			    body.mPosition.x(), body.mPosition.y());
+	}
+
+	return passed;
+}
+
+template <typename Step>
+std::uint64_t bench(const Grid& grid, std::vector<Body> bodies, const std::uint64_t steps, Step step) {
+	const std::uint64_t start = SDL_GetTicksNS();
+	for (std::uint64_t i = 0; i < steps; ++i) {
+		for (auto& body : bodies) {
+			body.mVelocity.y() -= G / 60.0f;
+			step(grid, body, 1.0f / 60.0f);
+		}
+	}
+
+	return SDL_GetTicksNS() - start;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	const std::uint64_t entities = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+	const std::uint64_t steps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 600;
+
+	if (entities == 0 || steps == 0) {
+		std::fprintf(stderr, "Usage: %s [entities] [steps]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	const auto cases = makeCases();
+	const bool swept = runCases("sweep   ", cases, sweepStep);
+	runCases("discrete", cases, discreteStep);
+
+	// Bumpy ground with boxes raining on it, walking sideways
+	constexpr const std::int64_t WIDTH = 256;
+	constexpr const std::int64_t HEIGHT = 64;
+	Grid grid = makeGrid(WIDTH, HEIGHT);
+	std::mt19937 random(42);
+	for (std::int64_t x = 0; x < WIDTH; ++x) {
+		const std::int64_t height = 4 + random() % 4;
+		for (std::int64_t y = 0; y < height; ++y) {
+			grid.mSolid[x * HEIGHT + y] = true;
+		}
+	}
+
+	std::vector<Body> bodies;
+	bodies.reserve(entities);
+	std::uniform_real_distribution<float> x(TILE, (WIDTH - 2) * TILE);
+	std::uniform_real_distribution<float> y(10 * TILE, (HEIGHT - 2) * TILE);
+	std::uniform_real_distribution<float> speed(-300.0f, 300.0f);
+	for (std::uint64_t i = 0; i < entities; ++i) {
+		bodies.emplace_back(Eigen::Vector2f(x(random), y(random)), Eigen::Vector2f(speed(random), 0.0f));
+	}
+
+	const std::uint64_t sweepTime = bench(grid, bodies, steps, sweepStep);
+	const std::uint64_t discreteTime = bench(grid, bodies, steps, discreteStep);
+
+	std::printf("%" PRIu64 " entities, %" PRIu64 " steps\n", entities, steps);
+	std::printf("sweep    %.2f ms, %.1f ns per entity step\n", sweepTime / 1e6,
+		    static_cast<double>(sweepTime) / (entities * steps));
+	std::printf("discrete %.2f ms, %.1f ns per entity step\n", discreteTime / 1e6,
+		    static_cast<double>(discreteTime) / (entities * steps));
+
+	return swept ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,142 @@
+// Headless world generation benchmark
+// Generates a range of chunks without a window or a GL context and prints the timings and a hash per chunk, so
+// changes to the world generation can be measured and caught
+// The generator reseeds its rng for every chunk from the seed and the chunk, so a chunk's hash doesn't depend on the
+// order. Every other run goes through the chunks backwards to check that
+//
+// Usage: worldgen_bench <seed> <first chunk> <last chunk> [runs]
+#include "components/noise.hpp"
+#include "items.hpp"
+#include "scenes/chunk.hpp"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+constexpr const static inline std::uint64_t FNV_OFFSET = 0xcbf29ce484222325;
+constexpr const static inline std::uint64_t FNV_PRIME = 0x100000001b3;
+
+void hashValue(std::uint64_t& hash, const std::uint64_t value) {
+	for (std::uint64_t i = 0; i < sizeof(value); ++i) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= FNV_PRIME;
+	}
+}
+
+std::uint64_t hashTiles(const Chunk::Tiles& tiles, const std::int64_t position) {
+	std::uint64_t hash = FNV_OFFSET;
+
+	hashValue(hash, static_cast<std::uint64_t>(position));
+	for (const auto& column : tiles.mGrid) {
+		for (const auto tile : column) {
+			hashValue(hash, static_cast<std::uint64_t>(tile));
+		}
+	}
+
+	for (const auto& [type, pos] : tiles.mOverflow) {
+		hashValue(hash, static_cast<std::uint64_t>(type));
+		hashValue(hash, static_cast<std::uint64_t>(pos.x()));
+		hashValue(hash, static_cast<std::uint64_t>(pos.y()));
+	}
+
+	return hash;
+}
+
+// Peak resident set size in KiB, 0 if unknown
+std::uint64_t peakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+
+#ifdef __APPLE__
+	// Bytes on darwin
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return 0;
+#endif
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc < 4) {
+		std::fprintf(stderr, "Usage: %s <seed> <first chunk> <last chunk> [runs]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	const std::uint64_t seed = std::strtoull(argv[1], nullptr, 10);
+	const std::int64_t first = std::strtoll(argv[2], nullptr, 10);
+	const std::int64_t last = std::strtoll(argv[3], nullptr, 10);
+	const std::uint64_t runs = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 2;
+
+	if (last < first || runs == 0) {
+		std::fprintf(stderr, "Invalid chunk range or run count\n");
+
+		return EXIT_FAILURE;
+	}
+
+	const std::uint64_t count = last - first + 1;
+	std::vector<std::uint64_t> hashes(count);
+	std::vector<std::uint64_t> times;
+	times.reserve(count * runs);
+
+	bool deterministic = true;
+	const std::uint64_t start = SDL_GetTicksNS();
+
+	for (std::uint64_t run = 0; run < runs; ++run) {
+		// Every run starts from a fresh generator, like a new world
+		NoiseGenerator noise(seed);
+
+		for (std::uint64_t i = 0; i < count; ++i) {
+			const std::int64_t position = run % 2 == 0 ? first + i : last - i;
+			const std::uint64_t before = SDL_GetTicksNS();
+			const Chunk::Tiles tiles = Chunk::generate(&noise, position);
+			times.emplace_back(SDL_GetTicksNS() - before);
+
+			const std::uint64_t hash = hashTiles(tiles, position);
+			if (run == 0) {
+				hashes[position - first] = hash;
+			} else if (hashes[position - first] != hash) {
+				std::fprintf(stderr, "Chunk %" PRIi64 " differs in run %" PRIu64 ": %016" PRIx64
+						     " != %016" PRIx64 "\n",
+					     position, run, hash, hashes[position - first]);
+
+				deterministic = false;
+			}
+		}
+	}
+
+	const std::uint64_t total = SDL_GetTicksNS() - start;
+
+	for (std::int64_t position = first; position <= last; ++position) {
+		std::printf("chunk %" PRIi64 " %016" PRIx64 "\n", position, hashes[position - first]);
+	}
+
+	std::sort(times.begin(), times.end());
+	const auto percentile = [&times](const double p) {
+		return times[static_cast<std::uint64_t>(p * (times.size() - 1))] / 1000.0;
+	};
+
+	std::printf("seed %" PRIu64 ", %" PRIu64 " chunks, %" PRIu64 " runs\n", seed, count, runs);
+	std::printf("chunks/sec: %.1f\n", static_cast<double>(count * runs) / (total / 1e9));
+	std::printf("p50: %.2f us\n", percentile(0.5));
+	std::printf("p99: %.2f us\n", percentile(0.99));
+	std::printf("peak memory: %" PRIu64 " KiB\n", peakMemory());
+	std::printf("deterministic: %s\n", deterministic ? "yes" : "no");
+
+	return deterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+}